@@ -0,0 +1,93 @@
+/*
+    Benchmark crontab generation.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QStringList>
+#include <QTest>
+#include <QTextStream>
+
+#include "ctcron.h"
+
+/**
+ * Gives access to the parser of a cron which is not read from anywhere.
+ */
+class BenchmarkCron : public CTCron
+{
+public:
+    BenchmarkCron()
+    {
+        d->systemCron = false;
+        d->multiUserCron = false;
+        d->currentUserCron = true;
+        d->loaded = true;
+    }
+
+    void parse(QTextStream *stream)
+    {
+        parseTextStream(stream);
+    }
+
+    void parse(const QString &crontab)
+    {
+        QString text = crontab;
+        QTextStream stream(&text, QIODevice::ReadOnly);
+        parseTextStream(&stream);
+    }
+
+    /**
+     * Reads the crontab from @p fileName, which reload() then reads again.
+     */
+    bool read(const QString &fileName)
+    {
+        d->fileName = fileName;
+        const bool read = parseFile(fileName);
+        finishLoading();
+        return read;
+    }
+};
+
+/**
+ * Synthetic crontab of @p lineCount lines, mixing what KCron and people
+ * write: comments, variables, lists, ranges, steps and nicknames.
+ */
+inline QString generateCrontab(int lineCount)
+{
+    static const QStringList lines{
+        QStringLiteral("#Backup the home folders"),
+        QStringLiteral("0 2 * * *\t/usr/local/bin/backup.sh --home"),
+        QStringLiteral("MAILTO=admin@example.com"),
+        QStringLiteral("*/5 8-18 * * 1-5  /usr/bin/check-queue > /dev/null 2>&1"),
+        QStringLiteral("#\\15,45 0,6,12,18 1,15 jan,jul sun\tdisabled-task"),
+        QStringLiteral("@daily /usr/sbin/logrotate /etc/logrotate.conf"),
+        QStringLiteral("30 4 1-7 * mon \"/opt/tools/monthly report\" --mail"),
+        QStringLiteral("PATH=/usr/local/bin:/usr/bin:/bin"),
+    };
+
+    QString crontab;
+    for (int i = 0; i < lineCount; ++i) {
+        crontab += lines.at(i % lines.count());
+        crontab += QLatin1Char('\n');
+    }
+
+    return crontab;
+}
+
+/**
+ * The crontab sizes benchmarks run against, from a tiny crontab to the
+ * largest system crontabs seen in the wild.
+ */
+inline void addCrontabSizes()
+{
+    QTest::addColumn<int>("lineCount");
+
+    QTest::newRow("10 lines") << 10;
+    QTest::newRow("1k lines") << 1000;
+    QTest::newRow("100k lines") << 100000;
+    QTest::newRow("1M lines") << 1000000;
+}
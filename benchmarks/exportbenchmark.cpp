@@ -0,0 +1,71 @@
+/*
+    Crontab export benchmark.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QBuffer>
+#include <QTest>
+
+#include "benchmarkCrontab.h"
+
+class ExportBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void exportCron_data();
+    void exportCron();
+
+    void writeCron_data();
+    void writeCron();
+};
+
+void ExportBenchmark::exportCron_data()
+{
+    addCrontabSizes();
+}
+
+void ExportBenchmark::exportCron()
+{
+    QFETCH(int, lineCount);
+
+    BenchmarkCron cron;
+    cron.parse(generateCrontab(lineCount));
+
+    QString exported;
+    QBENCHMARK {
+        exported = cron.exportCron();
+    }
+
+    QVERIFY(!exported.isEmpty());
+}
+
+void ExportBenchmark::writeCron_data()
+{
+    addCrontabSizes();
+}
+
+void ExportBenchmark::writeCron()
+{
+    QFETCH(int, lineCount);
+
+    BenchmarkCron cron;
+    cron.parse(generateCrontab(lineCount));
+
+    QByteArray exported;
+    QBENCHMARK {
+        exported.clear();
+        QBuffer buffer(&exported);
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY(cron.writeCron(&buffer));
+    }
+
+    QVERIFY(!exported.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(ExportBenchmark)
+
+#include "exportbenchmark.moc"
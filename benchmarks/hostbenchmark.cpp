@@ -0,0 +1,79 @@
+/*
+    Host creation benchmark.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <pwd.h>
+#include <unistd.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "benchmarkCrontab.h"
+#include "ctInitializationError.h"
+#include "cthost.h"
+
+/**
+ * Creates CTHost against a fake spool directory, holding a crontab of the
+ * current user, so that no crontab binary is run, and an empty fake system
+ * directory.
+ */
+class HostBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void createHost_data();
+    void createHost();
+};
+
+void HostBenchmark::createHost_data()
+{
+    addCrontabSizes();
+}
+
+void HostBenchmark::createHost()
+{
+    QFETCH(int, lineCount);
+
+    // Root reads the crontab of every user of the host.
+    if (getuid() == 0) {
+        QSKIP("Not run as root");
+    }
+
+    const struct passwd *userInfos = getpwuid(getuid());
+    QVERIFY(userInfos != nullptr);
+
+    QTemporaryDir spoolDirectory;
+    QVERIFY(spoolDirectory.isValid());
+
+    QFile crontab(spoolDirectory.filePath(QString::fromLocal8Bit(userInfos->pw_name)));
+    QVERIFY(crontab.open(QIODevice::WriteOnly));
+    crontab.write(generateCrontab(lineCount).toLocal8Bit());
+    crontab.close();
+
+    QTemporaryDir systemDirectory;
+    QVERIFY(systemDirectory.isValid());
+
+    QFile systemCrontab(systemDirectory.filePath(QStringLiteral("crontab")));
+    QVERIFY(systemCrontab.open(QIODevice::WriteOnly));
+    systemCrontab.close();
+    QVERIFY(QDir(systemDirectory.path()).mkdir(QStringLiteral("cron.d")));
+
+    QBENCHMARK {
+        CTInitializationError error;
+        CTHost host(QStringLiteral("crontab"), error, spoolDirectory.path(), true, systemDirectory.path());
+        if (error.hasErrorMessage()) {
+            QSKIP(qPrintable(error.errorMessage()));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(HostBenchmark)
+
+#include "hostbenchmark.moc"
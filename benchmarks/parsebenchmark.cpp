@@ -0,0 +1,102 @@
+/*
+    Crontab parsing benchmark.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTextStream>
+
+#include "benchmarkCrontab.h"
+
+class ParseBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void parseTextStream_data();
+    void parseTextStream();
+
+    void reloadChangedLine_data();
+    void reloadChangedLine();
+};
+
+static bool writeCrontab(const QString &fileName, const QString &crontab)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    return file.write(crontab.toUtf8()) >= 0;
+}
+
+void ParseBenchmark::parseTextStream_data()
+{
+    addCrontabSizes();
+}
+
+void ParseBenchmark::parseTextStream()
+{
+    QFETCH(int, lineCount);
+
+    QString crontab = generateCrontab(lineCount);
+
+    qint64 parsedLines = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        BenchmarkCron cron;
+        QTextStream stream(&crontab, QIODevice::ReadOnly);
+        cron.parse(&stream);
+        parsedLines += lineCount;
+    }
+
+    const qint64 elapsed = qMax<qint64>(timer.elapsed(), 1);
+    qInfo("Parsed %lld lines in %lld ms: %lld lines/sec", parsedLines, elapsed, parsedLines * 1000 / elapsed);
+}
+
+void ParseBenchmark::reloadChangedLine_data()
+{
+    addCrontabSizes();
+}
+
+/**
+ * Reloads a crontab file where a task is added or removed each time.
+ */
+void ParseBenchmark::reloadChangedLine()
+{
+    QFETCH(int, lineCount);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    const QString fileName = directory.filePath(QStringLiteral("crontab"));
+    const QString crontab = generateCrontab(lineCount);
+    const QString changedCrontab = QStringLiteral("0 3 * * *\t/usr/local/bin/changed.sh\n") + crontab;
+
+    QVERIFY(writeCrontab(fileName, crontab));
+
+    BenchmarkCron cron;
+    QVERIFY(cron.read(fileName));
+
+    bool changed = false;
+    QBENCHMARK {
+        changed = !changed;
+        QVERIFY(writeCrontab(fileName, changed ? changedCrontab : crontab));
+
+        CTCronChanges changes;
+        QVERIFY(cron.reload(&changes));
+        QCOMPARE(changes.addedTasks.count() + changes.removedTasks.count(), 1);
+    }
+}
+
+QTEST_GUILESS_MAIN(ParseBenchmark)
+
+#include "parsebenchmark.moc"
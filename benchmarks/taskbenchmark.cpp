@@ -0,0 +1,141 @@
+/*
+    Task and unit benchmark.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "cthour.h"
+#include "ctminute.h"
+#include "cttask.h"
+
+class TaskBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void describe_data();
+    void describe();
+
+    void describeUncached_data();
+    void describeUncached();
+
+    void exportUnit_data();
+    void exportUnit();
+
+    void findPeriod_data();
+    void findPeriod();
+};
+
+void TaskBenchmark::describe_data()
+{
+    QTest::addColumn<QString>("tokenString");
+
+    QTest::newRow("daily") << QStringLiteral("0 2 * * * /usr/local/bin/backup.sh");
+    QTest::newRow("step") << QStringLiteral("*/5 8-18 * * 1-5 /usr/bin/check-queue");
+    QTest::newRow("lists") << QStringLiteral("15,45 0,6,12,18 1,15 jan,jul sun /usr/bin/report");
+    QTest::newRow("every minute of office hours") << QStringLiteral("* 8-17 * * 1-5 /usr/bin/check-queue");
+    QTest::newRow("nickname") << QStringLiteral("@weekly /usr/sbin/logrotate");
+}
+
+void TaskBenchmark::describe()
+{
+    QFETCH(QString, tokenString);
+
+    const CTTask task(tokenString, QString(), QStringLiteral("user"));
+
+    // Only the first run creates the description, the others use the cached one.
+    QString description;
+    QBENCHMARK {
+        description = task.describe();
+    }
+
+    QVERIFY(!description.isEmpty());
+}
+
+void TaskBenchmark::describeUncached_data()
+{
+    describe_data();
+}
+
+void TaskBenchmark::describeUncached()
+{
+    QFETCH(QString, tokenString);
+
+    CTTask task(tokenString, QString(), QStringLiteral("user"));
+
+    // Changing the schedule on each run makes describe() create the description again.
+    QString description;
+    QBENCHMARK {
+        task.minute.setEnabled(59, !task.minute.isEnabled(59));
+        description = task.describe();
+    }
+
+    QVERIFY(!description.isEmpty());
+}
+
+void TaskBenchmark::exportUnit_data()
+{
+    QTest::addColumn<QString>("tokenString");
+
+    QTest::newRow("single") << QStringLiteral("30");
+    QTest::newRow("step") << QStringLiteral("*/5");
+    QTest::newRow("list") << QStringLiteral("0-3,5,6,10-30/5,47,59");
+    QTest::newRow("all") << QStringLiteral("*");
+}
+
+void TaskBenchmark::exportUnit()
+{
+    QFETCH(QString, tokenString);
+
+    CTMinute minute(tokenString);
+
+    // Unchanged units give back their initial token, benchmark the actual export.
+    minute.setEnabled(1, !minute.isEnabled(1));
+
+    QString exported;
+    QBENCHMARK {
+        exported = minute.exportUnit();
+    }
+
+    QVERIFY(!exported.isEmpty());
+}
+
+void TaskBenchmark::findPeriod_data()
+{
+    QTest::addColumn<QString>("minutes");
+    QTest::addColumn<QString>("hours");
+    QTest::addColumn<int>("minutePeriod");
+    QTest::addColumn<int>("hourPeriod");
+
+    QTest::newRow("periodic") << QStringLiteral("*/15") << QStringLiteral("*/2") << 15 << 2;
+    QTest::newRow("not periodic") << QStringLiteral("1,2,3,50") << QStringLiteral("0,7,8,23") << 0 << 0;
+}
+
+void TaskBenchmark::findPeriod()
+{
+    QFETCH(QString, minutes);
+    QFETCH(QString, hours);
+    QFETCH(int, minutePeriod);
+    QFETCH(int, hourPeriod);
+
+    const CTMinute minute(minutes);
+    const CTHour hour(hours);
+
+    int foundMinutePeriod = 0;
+    int foundHourPeriod = 0;
+    QBENCHMARK {
+        foundMinutePeriod = minute.findPeriod();
+        foundHourPeriod = hour.findPeriod();
+    }
+
+    QCOMPARE(foundMinutePeriod, minutePeriod);
+    QCOMPARE(foundHourPeriod, hourPeriod);
+}
+
+QTEST_GUILESS_MAIN(TaskBenchmark)
+
+#include "taskbenchmark.moc"
@@ -0,0 +1,123 @@
+/*
+    Timeline benchmark.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+#include "benchmarkCrontab.h"
+#include "ctTimeline.h"
+
+/**
+ * Queries the runs of every task of several crons, as a root session
+ * would for all users.
+ */
+class TimelineBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void firings_data();
+    void firings();
+
+    void nextFirings_data();
+    void nextFirings();
+
+private:
+    void addCronCounts();
+
+    /**
+     * Crons of 100 lines each.
+     */
+    static std::vector<std::unique_ptr<BenchmarkCron>> createCrons(int cronCount);
+
+    static QList<CTCron *> cronList(const std::vector<std::unique_ptr<BenchmarkCron>> &crons);
+};
+
+void TimelineBenchmark::addCronCounts()
+{
+    QTest::addColumn<int>("cronCount");
+
+    QTest::newRow("1 cron") << 1;
+    QTest::newRow("100 crons") << 100;
+    QTest::newRow("1k crons") << 1000;
+}
+
+std::vector<std::unique_ptr<BenchmarkCron>> TimelineBenchmark::createCrons(int cronCount)
+{
+    const QString crontab = generateCrontab(100);
+
+    std::vector<std::unique_ptr<BenchmarkCron>> crons;
+    for (int i = 0; i < cronCount; ++i) {
+        crons.push_back(std::make_unique<BenchmarkCron>());
+        crons.back()->parse(crontab);
+    }
+
+    return crons;
+}
+
+QList<CTCron *> TimelineBenchmark::cronList(const std::vector<std::unique_ptr<BenchmarkCron>> &crons)
+{
+    QList<CTCron *> cronList;
+    for (const auto &cron : crons) {
+        cronList.append(cron.get());
+    }
+
+    return cronList;
+}
+
+void TimelineBenchmark::firings_data()
+{
+    addCronCounts();
+}
+
+void TimelineBenchmark::firings()
+{
+    QFETCH(int, cronCount);
+
+    const auto crons = createCrons(cronCount);
+    CTTimeline timeline(cronList(crons));
+
+    // Queried again by the benchmark loop, which only walks the index.
+    const QDateTime begin(QDate(2024, 1, 1), QTime(0, 0));
+    const QDateTime end = begin.addSecs(60 * 60);
+
+    QList<CTFiring> firings;
+    QBENCHMARK {
+        firings = timeline.firings(begin, end);
+    }
+
+    QVERIFY(!firings.isEmpty());
+}
+
+void TimelineBenchmark::nextFirings_data()
+{
+    addCronCounts();
+}
+
+void TimelineBenchmark::nextFirings()
+{
+    QFETCH(int, cronCount);
+
+    const auto crons = createCrons(cronCount);
+    CTTimeline timeline(cronList(crons));
+
+    const QDateTime begin(QDate(2024, 1, 1), QTime(0, 0));
+
+    QList<CTFiring> firings;
+    QBENCHMARK {
+        firings = timeline.nextFirings(begin, 100);
+    }
+
+    QCOMPARE(firings.count(), 100);
+}
+
+QTEST_GUILESS_MAIN(TimelineBenchmark)
+
+#include "timelinebenchmark.moc"
@@ -14,9 +14,11 @@
 #include <QApplication>
 #include <QButtonGroup>
 #include <QClipboard>
+#include <QComboBox>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QRadioButton>
+#include <QSignalBlocker>
 #include <QSplitter>
 #include <QVBoxLayout>
 
@@ -24,15 +26,15 @@
 #include <KStandardAction>
 #include <QAction>
 
+#include "ctCommandIconCache.h"
+#include "ctCommandLineJob.h"
+#include "ctCronWatcher.h"
 #include "ctcron.h"
 #include "cthost.h"
 #include "cttask.h"
 #include "ctvariable.h"
 
 #include "crontabPrinter.h"
-#include "taskWidget.h"
-
-#include "variableWidget.h"
 
 #include "kcm_cron_debug.h"
 
@@ -40,19 +42,26 @@ CrontabWidget::CrontabWidget(QWidget *parent, CTHost *ctHost)
     : QWidget(parent)
 {
     mCtHost = ctHost;
+    mCommandIconCache = new CTCommandIconCache(this);
 
     setupActions();
 
     initialize();
 
+    if (mCtHost->watcher()) {
+        connect(mCtHost->watcher(), &CTCronWatcher::cronReloaded, this, &CrontabWidget::cronReloaded);
+        // Connected after the host, which updates its system crons first.
+        connect(mCtHost->watcher(), &CTCronWatcher::watchedDirectoryChanged, this, &CrontabWidget::systemCronsChanged);
+    }
+
     qCDebug(KCM_CRON_LOG) << "Clipboard Status " << hasClipboardContent();
 
     mTasksWidget->setFocus();
 
-    QTreeWidgetItem *item = mTasksWidget->treeWidget()->topLevelItem(0);
-    if (item != nullptr) {
-        qCDebug(KCM_CRON_LOG) << "First item found" << mTasksWidget->treeWidget()->topLevelItemCount();
-        item->setSelected(true);
+    const QModelIndex firstIndex = mTasksWidget->treeView()->model()->index(0, 0);
+    if (firstIndex.isValid()) {
+        qCDebug(KCM_CRON_LOG) << "First item found" << mTasksWidget->treeView()->model()->rowCount();
+        mTasksWidget->treeView()->selectionModel()->select(firstIndex, QItemSelectionModel::Select | QItemSelectionModel::Rows);
     }
 
     mTasksWidget->changeCurrentSelection();
@@ -95,13 +104,49 @@ QHBoxLayout *CrontabWidget::createCronSelector()
     group->addButton(mSystemCronRadio);
     layout->addWidget(mSystemCronRadio);
 
+    // Only shown if there are /etc/cron.d fragments.
+    mSystemCrons = new QComboBox(this);
+    fillSystemCrons();
+    mSystemCrons->setEnabled(false);
+    layout->addWidget(mSystemCrons);
+
     connect(group, static_cast<void (QButtonGroup::*)(QAbstractButton *)>(&QButtonGroup::buttonClicked), this, &CrontabWidget::refreshCron);
+    connect(mSystemCrons, &QComboBox::currentIndexChanged, this, &CrontabWidget::refreshCron);
 
     layout->addStretch(1);
 
     return layout;
 }
 
+void CrontabWidget::fillSystemCrons()
+{
+    const QString currentFileName = mSystemCrons->currentData().toString();
+
+    // Not a selection change, unless the current fragment was removed.
+    const QSignalBlocker blocker(mSystemCrons);
+
+    mSystemCrons->clear();
+    const auto systemCrons = mCtHost->systemCrons();
+    for (CTCron *ctCron : systemCrons) {
+        mSystemCrons->addItem(ctCron->fileName(), ctCron->fileName());
+    }
+
+    mSystemCrons->setCurrentIndex(qMax(0, mSystemCrons->findData(currentFileName)));
+    mSystemCrons->setVisible(mSystemCrons->count() > 1);
+}
+
+void CrontabWidget::systemCronsChanged()
+{
+    const QString currentFileName = mSystemCrons->currentData().toString();
+
+    fillSystemCrons();
+
+    // The host already deleted the crons of removed fragments.
+    if (mSystemCronRadio->isChecked() && mSystemCrons->currentData().toString() != currentFileName) {
+        refreshCron();
+    }
+}
+
 void CrontabWidget::initialize()
 {
     auto layout = new QVBoxLayout(this);
@@ -133,15 +178,53 @@ void CrontabWidget::refreshCron()
     // Refreshes the main GUI.
     CTCron *ctCron = currentCron();
 
+    mSystemCrons->setEnabled(mSystemCronRadio->isChecked());
+
+    // Shown empty until it has been read.
+    const bool loaded = ctCron->isLoaded();
+    if (!loaded) {
+        loadCron(ctCron);
+    }
+
     mTasksWidget->refreshTasks(ctCron);
     mVariablesWidget->refreshVariables(ctCron);
 
 
-    mTasksWidget->treeWidget()->setEnabled(true);
-    mVariablesWidget->treeWidget()->setEnabled(true);
+    mTasksWidget->treeView()->setEnabled(loaded);
+    mVariablesWidget->treeView()->setEnabled(loaded);
 
-    toggleNewEntryActions(true);
-    togglePasteAction(hasClipboardContent());
+    toggleNewEntryActions(loaded);
+    togglePasteAction(loaded && hasClipboardContent());
+}
+
+void CrontabWidget::loadCron(CTCron *ctCron)
+{
+    if (mLoadingCrons.contains(ctCron)) {
+        return;
+    }
+
+    qCDebug(KCM_CRON_LOG) << "Loading crontab of" << ctCron->userLogin();
+
+    mLoadingCrons.insert(ctCron);
+
+    CommandLineJob *loadJob = ctCron->createLoadJob(this);
+    connect(loadJob, &KJob::result, this, [this, ctCron]() {
+        mLoadingCrons.remove(ctCron);
+
+        // Left empty if it could not be read, selecting it again retries.
+        if (ctCron->isLoaded() && ctCron == currentCron()) {
+            refreshCron();
+        }
+    });
+    loadJob->start();
+}
+
+void CrontabWidget::cronReloaded(CTCron *ctCron, const CTCronChanges &changes)
+{
+    if (ctCron == currentCron()) {
+        mTasksWidget->refreshTasks(changes);
+        mVariablesWidget->refreshVariables(changes);
+    }
 }
 
 void CrontabWidget::copy()
@@ -154,24 +237,24 @@ void CrontabWidget::copy()
 
     QString clipboardText;
 
-    if (mTasksWidget->treeWidget()->hasFocus()) {
+    if (mTasksWidget->treeView()->hasFocus()) {
         qCDebug(KCM_CRON_LOG) << "Tasks copying";
 
-        const QList<TaskWidget *> tasksWidget = mTasksWidget->selectedTasksWidget();
-        for (TaskWidget *taskWidget : tasksWidget) {
-            auto task = new CTTask(*(taskWidget->getCTTask()));
+        const QList<CTTask *> selectedTasks = mTasksWidget->selectedTasks();
+        for (CTTask *selectedTask : selectedTasks) {
+            auto task = new CTTask(*selectedTask);
             mClipboardTasks.append(task);
 
             clipboardText += task->exportTask() + QLatin1String("\n");
         }
     }
 
-    if (mVariablesWidget->treeWidget()->hasFocus()) {
+    if (mVariablesWidget->treeView()->hasFocus()) {
         qCDebug(KCM_CRON_LOG) << "Variables copying";
 
-        const QList<VariableWidget *> variablesWidget = mVariablesWidget->selectedVariablesWidget();
-        for (VariableWidget *variableWidget : variablesWidget) {
-            auto variable = new CTVariable(*(variableWidget->getCTVariable()));
+        const QList<CTVariable *> selectedVariables = mVariablesWidget->selectedVariables();
+        for (CTVariable *selectedVariable : selectedVariables) {
+            auto variable = new CTVariable(*selectedVariable);
             mClipboardVariables.append(variable);
 
             clipboardText += variable->exportVariable() + QLatin1String("\n");
@@ -191,12 +274,12 @@ void CrontabWidget::cut()
 
     copy();
 
-    if (mTasksWidget->treeWidget()->hasFocus()) {
+    if (mTasksWidget->treeView()->hasFocus()) {
         qCDebug(KCM_CRON_LOG) << "Tasks cutting";
         mTasksWidget->deleteSelection();
     }
 
-    if (mVariablesWidget->treeWidget()->hasFocus()) {
+    if (mVariablesWidget->treeView()->hasFocus()) {
         qCDebug(KCM_CRON_LOG) << "Variables cutting";
         mVariablesWidget->deleteSelection();
     }
@@ -206,13 +289,13 @@ void CrontabWidget::paste()
 {
     qCDebug(KCM_CRON_LOG) << "Paste content";
 
-    if (mTasksWidget->treeWidget()->hasFocus()) {
+    if (mTasksWidget->treeView()->hasFocus()) {
         for (CTTask *task : std::as_const(mClipboardTasks)) {
             mTasksWidget->addTask(new CTTask(*task));
         }
     }
 
-    if (mVariablesWidget->treeWidget()->hasFocus()) {
+    if (mVariablesWidget->treeView()->hasFocus()) {
         for (CTVariable *variable : std::as_const(mClipboardVariables)) {
             mVariablesWidget->addVariable(new CTVariable(*variable));
         }
@@ -225,6 +308,8 @@ CTCron *CrontabWidget::currentCron() const
     // returning the appropriate cron.
     if (mCurrentUserCronRadio->isChecked()) {
         return mCtHost->findCurrentUserCron();
+    } else if (mSystemCrons->count() > 1) {
+        return mCtHost->findSystemCron(mSystemCrons->currentData().toString());
     } else {
         return mCtHost->findSystemCron();
     }
@@ -245,6 +330,11 @@ CTHost *CrontabWidget::ctHost() const
     return mCtHost;
 }
 
+CTCommandIconCache *CrontabWidget::commandIconCache() const
+{
+    return mCommandIconCache;
+}
+
 void CrontabWidget::checkOtherUsers()
 {
     mOtherUserCronRadio->setChecked(true);
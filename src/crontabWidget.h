@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <QSet>
 #include <QWidget>
 
 #include "tasksWidget.h"
@@ -15,8 +16,10 @@
 
 class QHBoxLayout;
 
+class CTCommandIconCache;
 class CTHost;
 class CTCron;
+class CTCronChanges;
 class QRadioButton;
 class QComboBox;
 
@@ -44,6 +47,11 @@ public:
 
     CTHost *ctHost() const;
 
+    /**
+     * Icons of the commands shown, destroyed along with the widget.
+     */
+    CTCommandIconCache *commandIconCache() const;
+
     CTCron *currentCron() const;
 
     QList<QAction *> cutCopyPasteActions();
@@ -73,6 +81,16 @@ protected Q_SLOTS:
 
     void checkOtherUsers();
 
+    /**
+     * Shows the new tasks and variables of @p ctCron if it is displayed.
+     */
+    void cronReloaded(CTCron *ctCron, const CTCronChanges &changes);
+
+    /**
+     * Lists the system crons again, after /etc/cron.d changed.
+     */
+    void systemCronsChanged();
+
 private:
     /**
      * Enables/disables paste button
@@ -94,6 +112,12 @@ private:
      */
     void setupActions();
 
+    /**
+     * Reads @p ctCron without blocking, and shows it once read if it is
+     * still the current one.
+     */
+    void loadCron(CTCron *ctCron);
+
     /**
      * Initialize view from underlying objects.
      */
@@ -101,6 +125,12 @@ private:
 
     QHBoxLayout *createCronSelector();
 
+    /**
+     * Lists the system crons of the host, keeping the current one if it
+     * still exists.
+     */
+    void fillSystemCrons();
+
     bool hasClipboardContent();
 
     /**
@@ -108,6 +138,13 @@ private:
      */
     CTHost *mCtHost = nullptr;
 
+    CTCommandIconCache *mCommandIconCache = nullptr;
+
+    /**
+     * Crons being read by loadCron().
+     */
+    QSet<CTCron *> mLoadingCrons;
+
     /**
      * Tree view of the crontab tasks.
      */
@@ -136,6 +173,11 @@ private:
     QRadioButton *mSystemCronRadio = nullptr;
     QRadioButton *mOtherUserCronRadio = nullptr;
 
+    /**
+     * System crontab files, /etc/crontab and its /etc/cron.d fragments.
+     */
+    QComboBox *mSystemCrons = nullptr;
+
     QComboBox *mOtherUsers = nullptr;
 
 };
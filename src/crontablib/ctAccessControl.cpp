@@ -0,0 +1,81 @@
+/*
+    CT Access Control Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctAccessControl.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+
+#include "kcm_cron_debug.h"
+
+CTAccessControl::CTAccessControl(const QString &allowFile, const QString &denyFile)
+{
+    mAllow.fileName = allowFile;
+    mDeny.fileName = denyFile;
+
+    refresh();
+}
+
+void CTAccessControl::refresh()
+{
+    refreshUserList(mAllow);
+    refreshUserList(mDeny);
+}
+
+void CTAccessControl::refreshUserList(UserList &userList)
+{
+    const QFileInfo fileInfo(userList.fileName);
+
+    // A file which can't be read is handled as a missing one, as before.
+    const bool exists = fileInfo.isFile() && fileInfo.isReadable();
+    if (exists == userList.exists && (!exists || (fileInfo.lastModified() == userList.lastModified && fileInfo.size() == userList.size))) {
+        return;
+    }
+
+    userList.exists = exists;
+    userList.lastModified = fileInfo.lastModified();
+    userList.size = fileInfo.size();
+    userList.users.clear();
+
+    if (!exists) {
+        return;
+    }
+
+    QFile file(userList.fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        userList.exists = false;
+        return;
+    }
+
+    qCDebug(KCM_CRON_LOG) << "Reading" << userList.fileName;
+
+    QTextStream stream(&file);
+    while (!stream.atEnd()) {
+        const QString user = stream.readLine().trimmed();
+        if (!user.isEmpty()) {
+            userList.users.insert(user);
+        }
+    }
+}
+
+bool CTAccessControl::isAllowed(const QString &userLogin) const
+{
+    // if cron.allow exists make sure user is listed
+    if (mAllow.exists) {
+        return mAllow.users.contains(userLogin);
+    }
+
+    // else if cron.deny exists make sure user is not listed
+    if (mDeny.exists) {
+        return !mDeny.users.contains(userLogin);
+    }
+
+    return true;
+}
@@ -0,0 +1,65 @@
+/*
+    CT Access Control Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QSet>
+#include <QString>
+
+/**
+ * Users allowed to use cron, according to /etc/cron.allow and
+ * /etc/cron.deny.
+ *
+ * If cron.allow exists, only the users it lists are allowed.  Otherwise,
+ * if cron.deny exists, every user it does not list is allowed.  If none
+ * of them exist, everybody is allowed.
+ *
+ * Both files are read once, and only read again by refresh() when their
+ * modification time or size has changed.
+ */
+class CTAccessControl
+{
+public:
+    explicit CTAccessControl(const QString &allowFile = QStringLiteral("/etc/cron.allow"), const QString &denyFile = QStringLiteral("/etc/cron.deny"));
+
+    /**
+     * Reads the files again if they have been created, modified or removed
+     * since the last time they were read.
+     */
+    void refresh();
+
+    /**
+     * Indicates whether or not @p userLogin may use cron.
+     * Does not access the file system.
+     */
+    bool isAllowed(const QString &userLogin) const;
+
+private:
+    /**
+     * State of one of the files, as last read.
+     */
+    class UserList
+    {
+    public:
+        QString fileName;
+
+        bool exists = false;
+
+        QDateTime lastModified;
+        qint64 size = -1;
+
+        QSet<QString> users;
+    };
+
+    static void refreshUserList(UserList &userList);
+
+    UserList mAllow;
+    UserList mDeny;
+};
@@ -0,0 +1,109 @@
+/*
+    CT Command Icon Cache Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctCommandIconCache.h"
+
+#include <QCoreApplication>
+#include <QMimeDatabase>
+#include <QPointer>
+#include <QThreadPool>
+#include <QUrl>
+
+/**
+ * Lookups running at once, more would mostly wait for the same file system.
+ */
+static const int MAXIMUM_LOOKUPS = 2;
+
+CTCommandIconCache::CTCommandIconCache(QObject *parent)
+    : QObject(parent)
+    , mPlaceholderIcon(QIcon::fromTheme(QStringLiteral("system-run")))
+    , mThreadPool(new QThreadPool())
+{
+    mThreadPool->setMaxThreadCount(MAXIMUM_LOOKUPS);
+}
+
+CTCommandIconCache::~CTCommandIconCache()
+{
+    // Lookups not started yet are not worth waiting for.
+    mThreadPool->clear();
+
+    // Deleting the pool waits for the running lookups, which a stalled mount could block
+    // forever, so it is left to them.  Their results are dropped.
+    if (mThreadPool->waitForDone(0)) {
+        delete mThreadPool;
+    }
+}
+
+QIcon CTCommandIconCache::icon(const QString &commandPath, bool *resolved)
+{
+    const auto it = mIcons.constFind(commandPath);
+    if (it != mIcons.constEnd()) {
+        if (resolved) {
+            *resolved = true;
+        }
+        return it.value();
+    }
+
+    if (resolved) {
+        *resolved = false;
+    }
+
+    if (mPendingCommandPaths.contains(commandPath)) {
+        return mPlaceholderIcon;
+    }
+
+    mPendingCommandPaths.insert(commandPath);
+
+    // Only the MIME type is found on the worker thread, icons belong to the GUI thread.
+    // The cache may be gone once the lookup ends, which the GUI thread checks.
+    const QPointer<CTCommandIconCache> cache(this);
+    mThreadPool->start([cache, commandPath]() {
+        const QUrl commandUrl = QUrl::fromLocalFile(commandPath);
+        const QMimeType mimeType = QMimeDatabase().mimeTypeForUrl(commandUrl);
+
+        QString iconName;
+        QString fallbackIconName;
+        if (mimeType.name() == QLatin1String("application/x-executable") || mimeType.name() == QLatin1String("application/octet-stream")) {
+            iconName = commandUrl.fileName();
+            fallbackIconName = QStringLiteral("system-run");
+        } else {
+            iconName = mimeType.iconName();
+        }
+
+        QCoreApplication *application = QCoreApplication::instance();
+        if (!application) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(
+            application,
+            [cache, commandPath, iconName, fallbackIconName]() {
+                if (cache) {
+                    cache->resolve(commandPath, iconName, fallbackIconName);
+                }
+            },
+            Qt::QueuedConnection);
+    });
+
+    return mPlaceholderIcon;
+}
+
+void CTCommandIconCache::resolve(const QString &commandPath, const QString &iconName, const QString &fallbackIconName)
+{
+    mPendingCommandPaths.remove(commandPath);
+
+    if (fallbackIconName.isEmpty()) {
+        mIcons.insert(commandPath, QIcon::fromTheme(iconName));
+    } else {
+        mIcons.insert(commandPath, QIcon::fromTheme(iconName, QIcon::fromTheme(fallbackIconName)));
+    }
+
+    Q_EMIT iconResolved(commandPath);
+}
+
+#include "moc_ctCommandIconCache.cpp"
@@ -0,0 +1,76 @@
+/*
+    CT Command Icon Cache Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QIcon>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+class QThreadPool;
+
+/**
+ * Icons of commands.
+ *
+ * Finding the MIME type of a command may read it, which can take long on
+ * network file systems, so it is done on worker threads of its own, which
+ * a stalled mount can't take from the rest of the process.  Until then, a
+ * placeholder icon is given, and iconResolved() tells when the actual one
+ * is known.
+ *
+ * Owned by the GUI, and destroyed before the application, without waiting
+ * for lookups still running.  Must be used from the GUI thread.
+ */
+class CTCommandIconCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CTCommandIconCache(QObject *parent = nullptr);
+
+    ~CTCommandIconCache() override;
+
+    /**
+     * Icon of the command at @p commandPath, or a placeholder icon if it is
+     * not known yet, in which case it is looked for in the background and
+     * @p resolved is set to false.
+     */
+    QIcon icon(const QString &commandPath, bool *resolved = nullptr);
+
+Q_SIGNALS:
+    /**
+     * The icon of the command at @p commandPath is now known.
+     */
+    void iconResolved(const QString &commandPath);
+
+private:
+    /**
+     * Copy construction not allowed.
+     */
+    CTCommandIconCache(const CTCommandIconCache &source);
+
+    /**
+     * Assignment not allowed
+     */
+    CTCommandIconCache &operator=(const CTCommandIconCache &source);
+
+    void resolve(const QString &commandPath, const QString &iconName, const QString &fallbackIconName);
+
+    QHash<QString, QIcon> mIcons;
+
+    /**
+     * Commands whose icon is being looked for.
+     */
+    QSet<QString> mPendingCommandPaths;
+
+    QIcon mPlaceholderIcon;
+
+    QThreadPool *mThreadPool = nullptr;
+};
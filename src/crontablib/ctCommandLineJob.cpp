@@ -0,0 +1,128 @@
+/*
+    CT Command Line Job Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctCommandLineJob.h"
+
+#include <QProcess>
+#include <QTimer>
+
+#include <KLocalizedString>
+
+#include "kcm_cron_debug.h"
+
+CommandLineJob::CommandLineJob(const CommandLine &commandLine, QObject *parent)
+    : KJob(parent)
+    , mCommandLine(commandLine)
+{
+    mCommandLineStatus.exitCode = 127;
+    mCommandLineStatus.commandLine = mCommandLine.commandLine + QLatin1String(" ") + mCommandLine.parameters.join(QLatin1String(" "));
+}
+
+CommandLineJob::~CommandLineJob()
+{
+    // Kills the command if it is still running.
+    delete mProcess;
+}
+
+void CommandLineJob::setTimeout(int timeout)
+{
+    mTimeout = timeout;
+}
+
+CommandLine CommandLineJob::commandLine() const
+{
+    return mCommandLine;
+}
+
+CommandLineStatus CommandLineJob::commandLineStatus() const
+{
+    return mCommandLineStatus;
+}
+
+void CommandLineJob::start()
+{
+    // Processes failing to start may finish synchronously, give the caller a chance to connect first.
+    QMetaObject::invokeMethod(this, &CommandLineJob::startProcess, Qt::QueuedConnection);
+}
+
+void CommandLineJob::startProcess()
+{
+    // Killed before being started.
+    if (isFinished()) {
+        return;
+    }
+
+    mProcess = new QProcess(this);
+
+    connect(mProcess, &QProcess::finished, this, [this](int exitCode) {
+        finish(exitCode);
+    });
+    connect(mProcess, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            finish(127);
+        }
+    });
+
+    if (mTimeout > 0) {
+        mTimer = new QTimer(this);
+        mTimer->setSingleShot(true);
+        connect(mTimer, &QTimer::timeout, this, &CommandLineJob::timeout);
+        mTimer->start(mTimeout);
+    }
+
+    mProcess->start(mCommandLine.commandLine, mCommandLine.parameters);
+}
+
+void CommandLineJob::finish(int exitCode)
+{
+    mCommandLineStatus.standardOutput = QLatin1String(mProcess->readAllStandardOutput());
+    mCommandLineStatus.standardError = QLatin1String(mProcess->readAllStandardError());
+    mCommandLineStatus.exitCode = exitCode;
+
+    mProcess->disconnect(this);
+    if (mTimer) {
+        mTimer->stop();
+    }
+
+    emitResult();
+}
+
+void CommandLineJob::timeout()
+{
+    qCDebug(KCM_CRON_LOG) << "Command" << mCommandLineStatus.commandLine << "timed out";
+
+    mProcess->disconnect(this);
+    mProcess->kill();
+
+    mCommandLineStatus.standardOutput = QLatin1String(mProcess->readAllStandardOutput());
+    mCommandLineStatus.standardError = QLatin1String(mProcess->readAllStandardError());
+    mCommandLineStatus.exitCode = CommandLineStatus::TimedOut;
+
+    setError(TimeoutError);
+    setErrorText(i18np("The command %2 did not finish within %1 second.",
+                       "The command %2 did not finish within %1 seconds.",
+                       mTimeout / 1000,
+                       mCommandLineStatus.commandLine));
+    emitResult();
+}
+
+bool CommandLineJob::doKill()
+{
+    if (mProcess) {
+        mProcess->disconnect(this);
+        mProcess->kill();
+    }
+
+    if (mTimer) {
+        mTimer->stop();
+    }
+
+    return true;
+}
+
+#include "moc_ctCommandLineJob.cpp"
@@ -0,0 +1,84 @@
+/*
+    CT Command Line Job Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <KJob>
+
+#include "ctcron.h"
+
+class QProcess;
+class QTimer;
+
+/**
+ * Runs a command line without blocking the event loop.
+ *
+ * The exit code of the command is part of commandLineStatus(), and is 127
+ * if it could not be started, as with CommandLine::execute().  Only a
+ * timeout is reported as an error of the job, with a TimedOut exit code.
+ *
+ * Killing the job kills the command.
+ */
+class CommandLineJob : public KJob
+{
+    Q_OBJECT
+
+public:
+    enum {
+        TimeoutError = KJob::UserDefinedError + 1,
+    };
+
+    explicit CommandLineJob(const CommandLine &commandLine, QObject *parent = nullptr);
+
+    ~CommandLineJob() override;
+
+    /**
+     * Kills the command if it did not finish within @p timeout
+     * milliseconds.  Zero, the default, waits forever.
+     */
+    void setTimeout(int timeout);
+
+    CommandLine commandLine() const;
+
+    /**
+     * Status of the command, once the job finished.
+     */
+    CommandLineStatus commandLineStatus() const;
+
+    void start() override;
+
+protected:
+    bool doKill() override;
+
+private:
+    /**
+     * Copy construction not allowed.
+     */
+    CommandLineJob(const CommandLineJob &source);
+
+    /**
+     * Assignment not allowed
+     */
+    CommandLineJob &operator=(const CommandLineJob &source);
+
+    void startProcess();
+
+    void finish(int exitCode);
+
+    void timeout();
+
+    CommandLine mCommandLine;
+
+    CommandLineStatus mCommandLineStatus;
+
+    QProcess *mProcess = nullptr;
+
+    QTimer *mTimer = nullptr;
+
+    int mTimeout = 0;
+};
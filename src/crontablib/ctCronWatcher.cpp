@@ -0,0 +1,179 @@
+/*
+    CT Cron Watcher Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctCronWatcher.h"
+
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QGuiApplication>
+#include <QTimer>
+
+#include "ctcron.h"
+
+#include "kcm_cron_debug.h"
+
+/**
+ * Time to wait for more events before reloading, in milliseconds.
+ */
+static const int COALESCING_DELAY = 500;
+
+CTCronWatcher::CTCronWatcher(QObject *parent)
+    : QObject(parent)
+    , mFileSystemWatcher(new QFileSystemWatcher(this))
+    , mTimer(new QTimer(this))
+{
+    mTimer->setSingleShot(true);
+    mTimer->setInterval(COALESCING_DELAY);
+
+    connect(mFileSystemWatcher, &QFileSystemWatcher::fileChanged, this, &CTCronWatcher::fileChanged);
+    connect(mFileSystemWatcher, &QFileSystemWatcher::directoryChanged, this, &CTCronWatcher::directoryChanged);
+    connect(mTimer, &QTimer::timeout, this, &CTCronWatcher::reloadChangedCrons);
+}
+
+CTCronWatcher::~CTCronWatcher()
+{
+}
+
+void CTCronWatcher::watchCron(CTCron *ctCron)
+{
+    const QString fileName = ctCron->fileName();
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    mCrons.insert(fileName, ctCron);
+
+    const FileStamp stamp = fileStamp(fileName);
+    mFileStamps.insert(ctCron, stamp);
+
+    if (stamp.exists) {
+        watchPath(fileName);
+    }
+
+    watchPath(QFileInfo(fileName).absolutePath());
+}
+
+void CTCronWatcher::unwatchCron(CTCron *ctCron)
+{
+    const QString fileName = ctCron->fileName();
+    if (mCrons.value(fileName) == ctCron) {
+        mCrons.remove(fileName);
+
+        if (mWatchedPaths.remove(fileName)) {
+            mFileSystemWatcher->removePath(fileName);
+        }
+    }
+
+    mFileStamps.remove(ctCron);
+    mPendingCrons.remove(ctCron);
+}
+
+void CTCronWatcher::watchDirectory(const QString &path)
+{
+    mDirectories.insert(path);
+    watchPath(path);
+}
+
+void CTCronWatcher::watchPath(const QString &path)
+{
+    if (mWatchedPaths.contains(path)) {
+        return;
+    }
+
+    if (mFileSystemWatcher->addPath(path)) {
+        mWatchedPaths.insert(path);
+    }
+}
+
+CTCronWatcher::FileStamp CTCronWatcher::fileStamp(const QString &fileName)
+{
+    const QFileInfo fileInfo(fileName);
+
+    FileStamp stamp;
+    stamp.exists = fileInfo.exists();
+    if (stamp.exists) {
+        stamp.size = fileInfo.size();
+        stamp.lastModified = fileInfo.lastModified();
+        stamp.metadataChangeTime = fileInfo.metadataChangeTime();
+    }
+
+    return stamp;
+}
+
+void CTCronWatcher::fileChanged(const QString &path)
+{
+    // A replaced or removed file is not watched anymore, it is watched again once reloaded.
+    mFileSystemWatcher->removePath(path);
+    mWatchedPaths.remove(path);
+
+    CTCron *ctCron = mCrons.value(path);
+    if (ctCron) {
+        mPendingCrons.insert(ctCron);
+        mTimer->start();
+    }
+}
+
+void CTCronWatcher::directoryChanged(const QString &path)
+{
+    // Only the directory is known, a crontab of it may have been created, replaced or removed.
+    for (auto it = mCrons.constBegin(); it != mCrons.constEnd(); ++it) {
+        if (QFileInfo(it.key()).absolutePath() == path) {
+            mPendingCrons.insert(it.value());
+        }
+    }
+
+    if (mDirectories.contains(path)) {
+        mPendingDirectories.insert(path);
+    }
+
+    if (!mPendingCrons.isEmpty() || !mPendingDirectories.isEmpty()) {
+        mTimer->start();
+    }
+}
+
+void CTCronWatcher::reloadChangedCrons()
+{
+    auto guiApplication = qobject_cast<QGuiApplication *>(QCoreApplication::instance());
+    if (guiApplication && guiApplication->modalWindow()) {
+        mTimer->start();
+        return;
+    }
+
+    const QSet<CTCron *> pendingCrons = mPendingCrons;
+    mPendingCrons.clear();
+
+    for (CTCron *ctCron : pendingCrons) {
+        const QString fileName = ctCron->fileName();
+
+        const FileStamp stamp = fileStamp(fileName);
+        if (stamp.exists) {
+            watchPath(fileName);
+        }
+
+        if (stamp == mFileStamps.value(ctCron)) {
+            continue;
+        }
+        mFileStamps.insert(ctCron, stamp);
+
+        qCDebug(KCM_CRON_LOG) << "Crontab file" << fileName << "changed";
+
+        CTCronChanges changes;
+        if (ctCron->reload(&changes)) {
+            Q_EMIT cronReloaded(ctCron, changes);
+        }
+    }
+
+    const QSet<QString> pendingDirectories = mPendingDirectories;
+    mPendingDirectories.clear();
+
+    for (const QString &directory : pendingDirectories) {
+        Q_EMIT watchedDirectoryChanged(directory);
+    }
+}
+
+#include "moc_ctCronWatcher.cpp"
@@ -0,0 +1,146 @@
+/*
+    CT Cron Watcher Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+class CTCron;
+class CTCronChanges;
+
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * Reloads crons whose crontab file changed on disk, for instance with
+ * "crontab -e" or by another administrator.
+ *
+ * Both the crontab files and their directories are watched, since
+ * crontabs are usually replaced rather than rewritten.  Events are
+ * coalesced, then only the crons whose file actually changed are reloaded
+ * with CTCron::reload().
+ *
+ * Reloading waits while a modal window is shown, since it could be editing
+ * a task or variable about to be deleted.
+ */
+class CTCronWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CTCronWatcher(QObject *parent = nullptr);
+
+    ~CTCronWatcher() override;
+
+    /**
+     * Watches the file of @p ctCron, see CTCron::fileName(), once it has
+     * been read.
+     */
+    void watchCron(CTCron *ctCron);
+
+    /**
+     * Stops watching the file of @p ctCron, before it is deleted.
+     */
+    void unwatchCron(CTCron *ctCron);
+
+    /**
+     * Tells with watchedDirectoryChanged() when files are created in or
+     * removed from @p path.
+     */
+    void watchDirectory(const QString &path);
+
+Q_SIGNALS:
+    /**
+     * Tasks and variables of @p ctCron have been replaced by the ones of
+     * its file, as listed by @p changes.
+     */
+    void cronReloaded(CTCron *ctCron, const CTCronChanges &changes);
+
+    /**
+     * Files may have been created in or removed from @p path, a directory
+     * given to watchDirectory().  Emitted after the crons of the directory
+     * have been reloaded.
+     */
+    void watchedDirectoryChanged(const QString &path);
+
+private:
+    /**
+     * Copy construction not allowed.
+     */
+    CTCronWatcher(const CTCronWatcher &source);
+
+    /**
+     * Assignment not allowed
+     */
+    CTCronWatcher &operator=(const CTCronWatcher &source);
+
+    /**
+     * What tells that a file changed.
+     */
+    class FileStamp
+    {
+    public:
+        bool exists = false;
+        qint64 size = 0;
+        QDateTime lastModified;
+        QDateTime metadataChangeTime;
+
+        bool operator==(const FileStamp &other) const
+        {
+            return exists == other.exists && size == other.size && lastModified == other.lastModified && metadataChangeTime == other.metadataChangeTime;
+        }
+    };
+
+    static FileStamp fileStamp(const QString &fileName);
+
+    /**
+     * Watches @p path, unless it is already.
+     */
+    void watchPath(const QString &path);
+
+    void fileChanged(const QString &path);
+
+    void directoryChanged(const QString &path);
+
+    void reloadChangedCrons();
+
+    QFileSystemWatcher *mFileSystemWatcher = nullptr;
+
+    /**
+     * Coalesces bursts of events.
+     */
+    QTimer *mTimer = nullptr;
+
+    /**
+     * Watched crons, by file name.
+     */
+    QHash<QString, CTCron *> mCrons;
+
+    QHash<CTCron *, FileStamp> mFileStamps;
+
+    /**
+     * Files and directories watched, QFileSystemWatcher only lists them by copy.
+     */
+    QSet<QString> mWatchedPaths;
+
+    /**
+     * Crons whose file may have changed.
+     */
+    QSet<CTCron *> mPendingCrons;
+
+    /**
+     * Directories given to watchDirectory(), and the ones which may have
+     * changed.
+     */
+    QSet<QString> mDirectories;
+    QSet<QString> mPendingDirectories;
+};
@@ -0,0 +1,130 @@
+/*
+    CT Cron Writer Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctCronWriter.h"
+
+#include <QCryptographicHash>
+#include <QIODevice>
+
+/**
+ * Largest amount of bytes kept before writing them to the device.
+ */
+static const qsizetype MAXIMUM_BUFFER_SIZE = 64 * 1024;
+
+CTCronWriter::CTCronWriter(QIODevice *device, qsizetype sizeHint)
+    : mDevice(device)
+    , mEncoder(QStringEncoder::Utf8)
+{
+    if (sizeHint <= 0 || sizeHint > MAXIMUM_BUFFER_SIZE) {
+        sizeHint = MAXIMUM_BUFFER_SIZE;
+    }
+
+    mBuffer.reserve(sizeHint);
+}
+
+CTCronWriter::CTCronWriter(QString *text, qsizetype sizeHint)
+    : mText(text)
+{
+    if (sizeHint > 0) {
+        mText->reserve(mText->size() + sizeHint);
+    }
+}
+
+CTCronWriter::CTCronWriter(QCryptographicHash *hash)
+    : mHash(hash)
+    , mEncoder(QStringEncoder::Utf8)
+{
+    mBuffer.reserve(MAXIMUM_BUFFER_SIZE);
+}
+
+CTCronWriter::~CTCronWriter()
+{
+    flush();
+}
+
+CTCronWriter &CTCronWriter::operator<<(QStringView text)
+{
+    if (mText != nullptr) {
+        mText->append(text);
+        return *this;
+    }
+
+    char *begin = reserve(mEncoder.requiredSpace(text.size()));
+    char *end = mEncoder.appendToBuffer(begin, text);
+    mBuffer.resize(end - mBuffer.constData());
+
+    return *this;
+}
+
+CTCronWriter &CTCronWriter::operator<<(QLatin1String text)
+{
+    if (mText != nullptr) {
+        mText->append(text);
+        return *this;
+    }
+
+    // Latin-1 characters take at most two bytes in UTF-8.
+    char *begin = reserve(text.size() * 2);
+    char *end = begin;
+    for (const char character : text) {
+        const uchar code = character;
+        if (code < 0x80) {
+            *end++ = character;
+        } else {
+            *end++ = char(0xC0 | (code >> 6));
+            *end++ = char(0x80 | (code & 0x3F));
+        }
+    }
+    mBuffer.resize(end - mBuffer.constData());
+
+    return *this;
+}
+
+CTCronWriter &CTCronWriter::operator<<(QChar character)
+{
+    return *this << QStringView(&character, 1);
+}
+
+char *CTCronWriter::reserve(qsizetype size)
+{
+    if (mBuffer.size() + size > mBuffer.capacity()) {
+        flush();
+        if (size > mBuffer.capacity()) {
+            mBuffer.reserve(size);
+        }
+    }
+
+    const qsizetype oldSize = mBuffer.size();
+    mBuffer.resize(oldSize + size);
+    return mBuffer.data() + oldSize;
+}
+
+bool CTCronWriter::flush()
+{
+    if (mBuffer.isEmpty()) {
+        return !mError;
+    }
+
+    if (mHash != nullptr) {
+        mHash->addData(mBuffer);
+    }
+    // Writes the bytes rather than the array, so that the device does not share it.
+    else if (mDevice->write(mBuffer.constData(), mBuffer.size()) != mBuffer.size()) {
+        mError = true;
+    }
+
+    // Keeps the capacity for the next pieces.
+    mBuffer.resize(0);
+
+    return !mError;
+}
+
+bool CTCronWriter::hasError() const
+{
+    return mError;
+}
@@ -0,0 +1,88 @@
+/*
+    CT Cron Writer Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringEncoder>
+#include <QStringView>
+
+class QCryptographicHash;
+class QIODevice;
+
+/**
+ * Writes crontab text piece by piece, either to a device, in UTF-8, into a
+ * hash of that UTF-8 text, or appended to a string.
+ *
+ * Writing to a device goes through a buffer of bounded size, reserved once,
+ * so that exporting a crontab never holds it whole in memory.
+ */
+class CTCronWriter
+{
+public:
+    /**
+     * Writes to @p device, expecting about @p sizeHint characters.
+     */
+    explicit CTCronWriter(QIODevice *device, qsizetype sizeHint = 0);
+
+    /**
+     * Appends to @p text, expecting about @p sizeHint characters.
+     */
+    explicit CTCronWriter(QString *text, qsizetype sizeHint = 0);
+
+    /**
+     * Adds the UTF-8 text to @p hash.
+     */
+    explicit CTCronWriter(QCryptographicHash *hash);
+
+    /**
+     * Flushes what remains in the buffer.
+     */
+    ~CTCronWriter();
+
+    CTCronWriter &operator<<(QStringView text);
+    CTCronWriter &operator<<(QLatin1String text);
+    CTCronWriter &operator<<(QChar character);
+
+    /**
+     * Writes the buffer to the device, or adds it to the hash.
+     * Returns false if the device failed to write at some point.
+     */
+    bool flush();
+
+    bool hasError() const;
+
+private:
+    /**
+     * Copy construction not allowed.
+     */
+    CTCronWriter(const CTCronWriter &source);
+
+    /**
+     * Assignment not allowed
+     */
+    CTCronWriter &operator=(const CTCronWriter &source);
+
+    /**
+     * Makes room for @p size more bytes in the buffer, flushing it if needed.
+     */
+    char *reserve(qsizetype size);
+
+    QIODevice *mDevice = nullptr;
+
+    QString *mText = nullptr;
+
+    QCryptographicHash *mHash = nullptr;
+
+    QStringEncoder mEncoder;
+
+    QByteArray mBuffer;
+
+    bool mError = false;
+};
@@ -8,24 +8,28 @@
 
 #include "ctHelper.h"
 
-#include <QStringList>
-
 #include <KLocalizedString>
 
+#include "ctCronWriter.h"
+
 QString CTHelper::exportComment(const QString &comment)
 {
     QString exportComment;
 
+    CTCronWriter writer(&exportComment);
+    writeComment(writer, comment);
+
+    return exportComment;
+}
+
+void CTHelper::writeComment(CTCronWriter &writer, const QString &comment)
+{
     if (comment.isEmpty()) {
-        const QString noComment = i18n("No comment");
-        exportComment += QLatin1String("#") + noComment + QLatin1String("\n");
-        return exportComment;
+        writer << QLatin1Char('#') << i18n("No comment") << QLatin1Char('\n');
+        return;
     }
 
-    const QStringList lines = comment.split(QStringLiteral("\n"));
-    for (const QString &line : lines) {
-        exportComment += QLatin1String("#") + line + QLatin1String("\n");
+    for (const QStringView line : QStringView(comment).tokenize(QLatin1Char('\n'))) {
+        writer << QLatin1Char('#') << line << QLatin1Char('\n');
     }
-
-    return exportComment;
 }
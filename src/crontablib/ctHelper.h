@@ -10,9 +10,13 @@
 
 #include <QString>
 
+class CTCronWriter;
+
 class CTHelper
 {
 public:
     static QString exportComment(const QString &comment);
+
+    static void writeComment(CTCronWriter &writer, const QString &comment);
 };
 
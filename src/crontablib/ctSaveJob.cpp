@@ -0,0 +1,229 @@
+/*
+    CT Save Job Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctSaveJob.h"
+
+#include <QTemporaryFile>
+
+#include <KLocalizedString>
+
+// For root permissions
+#include <KAuth/Action>
+#include <KAuth/ExecuteJob>
+
+#include "ctCommandLineJob.h"
+#include "ctcron.h"
+
+#include "kcm_cron_debug.h"
+
+CTSaveJob::CTSaveJob(const QList<CTCron *> &ctCrons, QObject *parent)
+    : KJob(parent)
+    , mCtCrons(ctCrons)
+{
+    setProgressUnit(KJob::Items);
+}
+
+CTSaveJob::~CTSaveJob()
+{
+}
+
+void CTSaveJob::setTimeout(int timeout)
+{
+    mTimeout = timeout;
+}
+
+QList<CTCron *> CTSaveJob::crons() const
+{
+    return mCtCrons;
+}
+
+CTSaveStatus CTSaveJob::saveStatus() const
+{
+    return mSaveStatus;
+}
+
+void CTSaveJob::start()
+{
+    QMetaObject::invokeMethod(this, &CTSaveJob::startSaving, Qt::QueuedConnection);
+}
+
+void CTSaveJob::startSaving()
+{
+    // Killed before being started.
+    if (isFinished()) {
+        return;
+    }
+
+    QList<CTCron *> userCrons;
+    QList<CTCron *> systemCrons;
+    for (CTCron *ctCron : mCtCrons) {
+        ctCron->ensureLoaded();
+
+        const QByteArray contentHash = ctCron->contentHash();
+        if (contentHash == ctCron->savedContentHash()) {
+            qCDebug(KCM_CRON_LOG) << "Content of the crontab of" << ctCron->userLogin() << "did not change, not saving it";
+            ctCron->markSaved(contentHash);
+            continue;
+        }
+
+        QTemporaryFile *temporaryFile = writeTemporaryFile(ctCron);
+        if (temporaryFile == nullptr) {
+            return;
+        }
+
+        mContentHashes.insert(ctCron, contentHash);
+        mTemporaryFiles.insert(ctCron, temporaryFile);
+
+        if (ctCron->isSystemCron()) {
+            systemCrons.append(ctCron);
+        } else {
+            userCrons.append(ctCron);
+        }
+    }
+
+    setTotalAmount(KJob::Items, userCrons.count() + systemCrons.count());
+
+    for (CTCron *ctCron : std::as_const(userCrons)) {
+        saveUserCron(ctCron);
+    }
+
+    if (!systemCrons.isEmpty()) {
+        saveSystemCrons(systemCrons);
+    }
+
+    if (mSubJobs.isEmpty()) {
+        emitResult();
+    }
+}
+
+QTemporaryFile *CTSaveJob::writeTemporaryFile(CTCron *ctCron)
+{
+    auto temporaryFile = new QTemporaryFile(this);
+    if (!temporaryFile->open()) {
+        setSaveStatus(CTSaveStatus(i18n("Unable to open crontab file for writing"), i18n("The file %1 could not be opened.", temporaryFile->fileName())));
+        emitResult();
+        return nullptr;
+    }
+
+    if (!ctCron->writeCron(temporaryFile)) {
+        setSaveStatus(CTSaveStatus(i18n("Unable to open crontab file for writing"), i18n("The file %1 could not be written.", temporaryFile->fileName())));
+        emitResult();
+        return nullptr;
+    }
+    temporaryFile->close();
+
+    return temporaryFile;
+}
+
+void CTSaveJob::saveUserCron(CTCron *ctCron)
+{
+    qCDebug(KCM_CRON_LOG) << "Attempting to save user cron of" << ctCron->userLogin();
+
+    // Save without root permissions.
+    auto writeJob = new CommandLineJob(ctCron->writeCommandLine(mTemporaryFiles.value(ctCron)->fileName()), this);
+    writeJob->setTimeout(mTimeout);
+
+    connect(writeJob, &KJob::result, this, [this, ctCron, writeJob]() {
+        const CommandLineStatus commandLineStatus = writeJob->commandLineStatus();
+        if (writeJob->error() == CommandLineJob::TimeoutError) {
+            setSaveStatus(CTSaveStatus(i18n("An error occurred while updating crontab."), writeJob->errorText()));
+        } else if (commandLineStatus.exitCode != 0) {
+            setSaveStatus(ctCron->prepareSaveStatusError(commandLineStatus));
+        } else {
+            cronSaved(ctCron);
+        }
+
+        subJobFinished(writeJob);
+    });
+
+    mSubJobs.append(writeJob);
+    writeJob->start();
+}
+
+void CTSaveJob::saveSystemCrons(const QList<CTCron *> &systemCrons)
+{
+    // For root permissions.
+    qCDebug(KCM_CRON_LOG) << "Attempting to save" << systemCrons.count() << "system crons";
+
+    QVariantList manifest;
+    for (CTCron *ctCron : systemCrons) {
+        QVariantMap entry;
+        entry.insert(QStringLiteral("source"), mTemporaryFiles.value(ctCron)->fileName());
+        entry.insert(QStringLiteral("target"), ctCron->fileName());
+        manifest.append(entry);
+    }
+
+    QVariantMap args;
+    args.insert(QStringLiteral("manifest"), manifest);
+    KAuth::Action saveAction(QStringLiteral("local.kcron.crontab.savebatch"));
+    saveAction.setHelperId(QStringLiteral("local.kcron.crontab"));
+    saveAction.setArguments(args);
+
+    KAuth::ExecuteJob *authJob = saveAction.execute();
+
+    connect(authJob, &KJob::result, this, [this, systemCrons, authJob]() {
+        // The helper puts the previous crontabs back if one of them can't be installed.
+        if (authJob->error() > 0) {
+            qCDebug(KCM_CRON_LOG) << "KAuth returned an error: " << authJob->error() << authJob->errorText();
+            setSaveStatus(CTSaveStatus(i18n("KAuth::ExecuteJob Error"), authJob->errorText()));
+        } else {
+            for (CTCron *ctCron : systemCrons) {
+                cronSaved(ctCron);
+            }
+        }
+
+        subJobFinished(authJob);
+    });
+    // End root permissions.
+
+    mSubJobs.append(authJob);
+    authJob->start();
+}
+
+void CTSaveJob::cronSaved(CTCron *ctCron)
+{
+    ctCron->markSaved(mContentHashes.value(ctCron));
+
+    setProcessedAmount(KJob::Items, processedAmount(KJob::Items) + 1);
+}
+
+void CTSaveJob::setSaveStatus(const CTSaveStatus &saveStatus)
+{
+    if (mSaveStatus.isError()) {
+        return;
+    }
+
+    mSaveStatus = saveStatus;
+
+    setError(KJob::UserDefinedError);
+    setErrorText(saveStatus.errorMessage());
+}
+
+void CTSaveJob::subJobFinished(KJob *subJob)
+{
+    mSubJobs.removeOne(subJob);
+
+    if (mSubJobs.isEmpty()) {
+        qCDebug(KCM_CRON_LOG) << "Saving finished";
+        emitResult();
+    }
+}
+
+bool CTSaveJob::doKill()
+{
+    // Killing the authorization only stops waiting for the helper.
+    const auto subJobs = mSubJobs;
+    mSubJobs.clear();
+    for (KJob *subJob : subJobs) {
+        subJob->kill();
+    }
+
+    return true;
+}
+
+#include "moc_ctSaveJob.cpp"
@@ -0,0 +1,122 @@
+/*
+    CT Save Job Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <KJob>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+#include "ctSaveStatus.h"
+
+class CTCron;
+
+class QTemporaryFile;
+
+/**
+ * Saves crons without blocking the event loop.
+ *
+ * User crontabs are installed with the crontab binary, all of them at
+ * once. System crontabs, /etc/crontab and its /etc/cron.d fragments, are
+ * installed together by a single KAuth helper action, so that the
+ * authorization is only asked for once and either all of them or none are
+ * replaced. Crons whose content did not change are not rewritten.
+ * Progress is reported in crontabs written.
+ *
+ * The crons must outlive the job, and must not be modified while it runs.
+ * Once the job finished, saveStatus() describes the first error, if any;
+ * the crons which could be saved are clean anyway. Killing the job leaves
+ * the crons being saved dirty, whether or not they were actually
+ * installed.
+ */
+class CTSaveJob : public KJob
+{
+    Q_OBJECT
+
+public:
+    explicit CTSaveJob(const QList<CTCron *> &ctCrons, QObject *parent = nullptr);
+
+    ~CTSaveJob() override;
+
+    /**
+     * Kills the crontab binary if it did not finish within @p timeout
+     * milliseconds, 30 seconds by default.  Zero waits forever.
+     * The authorization is always waited for, since it can ask for a password.
+     */
+    void setTimeout(int timeout);
+
+    QList<CTCron *> crons() const;
+
+    CTSaveStatus saveStatus() const;
+
+    void start() override;
+
+protected:
+    bool doKill() override;
+
+private:
+    /**
+     * Copy construction not allowed.
+     */
+    CTSaveJob(const CTSaveJob &source);
+
+    /**
+     * Assignment not allowed
+     */
+    CTSaveJob &operator=(const CTSaveJob &source);
+
+    void startSaving();
+
+    /**
+     * Writes the crontab format of @p ctCron to a temporary file, removed
+     * along with the job.  Returns nullptr, after ending the job, on error.
+     */
+    QTemporaryFile *writeTemporaryFile(CTCron *ctCron);
+
+    void saveUserCron(CTCron *ctCron);
+
+    /**
+     * Installs @p systemCrons in one transaction.
+     */
+    void saveSystemCrons(const QList<CTCron *> &systemCrons);
+
+    /**
+     * Marks @p ctCron as saved.
+     */
+    void cronSaved(CTCron *ctCron);
+
+    /**
+     * Keeps @p saveStatus if it is the first error.
+     */
+    void setSaveStatus(const CTSaveStatus &saveStatus);
+
+    /**
+     * Ends the job once @p subJob, which just finished, was the last one.
+     */
+    void subJobFinished(KJob *subJob);
+
+    const QList<CTCron *> mCtCrons;
+
+    CTSaveStatus mSaveStatus;
+
+    /**
+     * Content hashes of the crons being saved.
+     */
+    QHash<CTCron *, QByteArray> mContentHashes;
+
+    QHash<CTCron *, QTemporaryFile *> mTemporaryFiles;
+
+    /**
+     * Commands and authorizations running.
+     */
+    QList<KJob *> mSubJobs;
+
+    int mTimeout = 30 * 1000;
+};
@@ -26,8 +26,8 @@ public:
 private:
     bool mErrorStatus = true;
 
-    const QString mError;
+    QString mError;
 
-    const QString mDetailError;
+    QString mDetailError;
 };
 
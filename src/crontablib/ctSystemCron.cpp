@@ -19,7 +19,7 @@
 
 #include "kcm_cron_debug.h"
 
-CTSystemCron::CTSystemCron(const QString &crontabBinary)
+CTSystemCron::CTSystemCron(const QString &crontabBinary, const QString &fileName)
     : CTCron()
 {
     d->systemCron = true;
@@ -31,18 +31,14 @@ CTSystemCron::CTSystemCron(const QString &crontabBinary)
     d->userLogin = i18n("root");
     d->userRealName = d->userLogin;
 
-    d->initialTaskCount = 0;
-    d->initialVariableCount = 0;
-
     // Don't set error if it can't be read, it means the user
     // doesn't have a crontab.
-    const QString crontabFile = QStringLiteral("/etc/crontab");
-    if (QFileInfo::exists(crontabFile)) {
-        parseFile(crontabFile);
+    d->fileName = fileName;
+    if (QFileInfo::exists(d->fileName)) {
+        parseFile(d->fileName);
     }
 
-    d->initialTaskCount = d->task.size();
-    d->initialVariableCount = d->variable.size();
+    finishLoading();
 }
 
 CTSystemCron::~CTSystemCron()
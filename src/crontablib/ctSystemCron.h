@@ -22,8 +22,11 @@ public:
      * Default is to construct from the user's crontab.  Can also be called,
      * passing TRUE, to construct from the system crontab.  Throws an
      * exception if the crontab file can not be found, read, or parsed.
+     *
+     * @p fileName is either the system crontab or a fragment of
+     * /etc/cron.d, which has the same format.
      */
-    explicit CTSystemCron(const QString &cronBinary);
+    explicit CTSystemCron(const QString &cronBinary, const QString &fileName = QStringLiteral("/etc/crontab"));
 
     /**
      * Destructor.
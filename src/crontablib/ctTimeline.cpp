@@ -0,0 +1,244 @@
+/*
+    CT Timeline Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctTimeline.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "ctcron.h"
+#include "cttask.h"
+
+namespace
+{
+/**
+ * std heap functions build a max-heap, so the ordering is reversed.
+ */
+template<typename T>
+bool laterThan(const T &first, const T &second)
+{
+    return second < first;
+}
+
+/**
+ * First run of @p task at or after @p begin.
+ */
+QDateTime firstRun(CTTask *task, const QDateTime &begin)
+{
+    // nextOccurrence() is exclusive, step back to include begin itself.
+    return task->nextOccurrence(begin.addSecs(-1));
+}
+}
+
+bool CTTimeline::Run::operator<(const Run &other) const
+{
+    if (time != other.time) {
+        return time < other.time;
+    }
+
+    return sequence < other.sequence;
+}
+
+CTTimeline::CTTimeline(const QList<CTCron *> &crons)
+{
+    for (CTCron *ctCron : crons) {
+        addCron(ctCron);
+    }
+}
+
+CTTimeline::~CTTimeline()
+{
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        ctCron->setTimeline(nullptr);
+    }
+}
+
+void CTTimeline::addCron(CTCron *cron)
+{
+    mCrons.append(cron);
+    cron->setTimeline(this);
+
+    // A lazy crontab is indexed once it has been read, see refreshCron().
+    if (!cron->isLoaded()) {
+        return;
+    }
+
+    const auto tasks = cron->tasks();
+    for (CTTask *ctTask : tasks) {
+        addTask(cron, ctTask);
+    }
+}
+
+void CTTimeline::removeCron(CTCron *cron)
+{
+    for (auto it = mTasks.begin(); it != mTasks.end();) {
+        if (it->cron == cron) {
+            unschedule(it.key(), it.value());
+            it = mTasks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    cron->setTimeline(nullptr);
+    mCrons.removeAll(cron);
+}
+
+void CTTimeline::refreshCron(CTCron *cron)
+{
+    // Tasks may have been deleted, so look them up from the index.
+    for (auto it = mTasks.begin(); it != mTasks.end();) {
+        if (it->cron == cron) {
+            unschedule(it.key(), it.value());
+            it = mTasks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!cron->isLoaded()) {
+        return;
+    }
+
+    const auto tasks = cron->tasks();
+    for (CTTask *ctTask : tasks) {
+        addTask(cron, ctTask);
+    }
+}
+
+void CTTimeline::addTask(CTCron *cron, CTTask *task)
+{
+    removeTask(task);
+
+    Entry &entry = mTasks[task];
+    entry.cron = cron;
+    entry.sequence = mNextSequence++;
+    schedule(task, entry);
+}
+
+void CTTimeline::modifyTask(CTTask *task)
+{
+    const auto it = mTasks.find(task);
+    if (it == mTasks.end()) {
+        return;
+    }
+
+    unschedule(task, it.value());
+    schedule(task, it.value());
+}
+
+void CTTimeline::removeTask(CTTask *task)
+{
+    const auto it = mTasks.find(task);
+    if (it == mTasks.end()) {
+        return;
+    }
+
+    unschedule(task, it.value());
+    mTasks.erase(it);
+}
+
+void CTTimeline::schedule(CTTask *task, Entry &entry) const
+{
+    // Computed by the first query otherwise.
+    if (!mCursor.isValid()) {
+        entry.next = QDateTime();
+        return;
+    }
+
+    entry.next = firstRun(task, mCursor);
+    if (entry.next.isValid()) {
+        mRuns.insert(Run{entry.next, entry.sequence, task, entry.cron});
+    }
+}
+
+void CTTimeline::unschedule(CTTask *task, const Entry &entry) const
+{
+    // The task itself is not used, it may have been deleted.
+    if (entry.next.isValid()) {
+        mRuns.erase(Run{entry.next, entry.sequence, task, entry.cron});
+    }
+}
+
+void CTTimeline::moveCursor(const QDateTime &begin) const
+{
+    if (mCursor.isValid() && begin >= mCursor) {
+        // Only the runs now in the past are computed again.
+        while (!mRuns.empty() && mRuns.begin()->time < begin) {
+            Run run = *mRuns.begin();
+            mRuns.erase(mRuns.begin());
+
+            run.time = firstRun(run.task, begin);
+            mTasks[run.task].next = run.time;
+            if (run.time.isValid()) {
+                mRuns.insert(run);
+            }
+        }
+
+        mCursor = begin;
+        return;
+    }
+
+    mCursor = begin;
+    mRuns.clear();
+    for (auto it = mTasks.begin(); it != mTasks.end(); ++it) {
+        schedule(it.key(), it.value());
+    }
+}
+
+QList<CTFiring> CTTimeline::firings(const QDateTime &begin, const QDateTime &end) const
+{
+    return merge(begin, end, -1);
+}
+
+QList<CTFiring> CTTimeline::nextFirings(const QDateTime &begin, int count) const
+{
+    return merge(begin, QDateTime(), count);
+}
+
+QList<CTFiring> CTTimeline::merge(const QDateTime &begin, const QDateTime &end, int count) const
+{
+    QList<CTFiring> result;
+    if (count == 0) {
+        return result;
+    }
+
+    moveCursor(begin);
+
+    // Runs following the ones already returned, the index only has the first one of each task.
+    std::vector<Run> followingRuns;
+
+    auto next = mRuns.cbegin();
+    while (count < 0 || result.count() < count) {
+        Run run;
+        if (next != mRuns.cend() && (followingRuns.empty() || *next < followingRuns.front())) {
+            run = *next;
+            ++next;
+        } else if (!followingRuns.empty()) {
+            std::pop_heap(followingRuns.begin(), followingRuns.end(), laterThan<Run>);
+            run = followingRuns.back();
+            followingRuns.pop_back();
+        } else {
+            break;
+        }
+
+        if (end.isValid() && run.time >= end) {
+            break;
+        }
+
+        result.append(CTFiring{run.time, run.task, run.cron});
+
+        run.time = run.task->nextOccurrence(run.time);
+        if (run.time.isValid()) {
+            followingRuns.push_back(run);
+            std::push_heap(followingRuns.begin(), followingRuns.end(), laterThan<Run>);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,146 @@
+/*
+    CT Timeline Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+
+#include <set>
+
+class CTCron;
+class CTTask;
+
+/**
+ * A single run of a task, as scheduled by cron.
+ */
+class CTFiring
+{
+public:
+    QDateTime time;
+
+    CTTask *task;
+
+    CTCron *cron;
+};
+
+/**
+ * Host wide index of the upcoming runs of every task of every cron.
+ *
+ * The next run of each task is kept in an ordered set, updated when tasks
+ * are added, modified or removed.  A query only advances the runs it goes
+ * past, and walks the set, computing the following runs of a task only once
+ * it has been returned.  Runs at the same time are returned in indexing
+ * order.
+ *
+ * Crons which have not been read yet are not read by the timeline, their
+ * tasks are indexed once they are.
+ */
+class CTTimeline
+{
+public:
+    /**
+     * Indexes the tasks of @p crons, and keeps track of their changes.
+     */
+    explicit CTTimeline(const QList<CTCron *> &crons);
+
+    /**
+     * Detaches from the indexed crons.
+     */
+    ~CTTimeline();
+
+    void addCron(CTCron *cron);
+    void removeCron(CTCron *cron);
+
+    /**
+     * Re-index every task of @p cron, after it has been read, replaced or
+     * its changes cancelled.
+     */
+    void refreshCron(CTCron *cron);
+
+    void addTask(CTCron *cron, CTTask *task);
+    void modifyTask(CTTask *task);
+    void removeTask(CTTask *task);
+
+    /**
+     * All runs happening at or after @p begin and before @p end, sorted by time.
+     */
+    QList<CTFiring> firings(const QDateTime &begin, const QDateTime &end) const;
+
+    /**
+     * The @p count first runs happening at or after @p begin, sorted by time.
+     */
+    QList<CTFiring> nextFirings(const QDateTime &begin, int count) const;
+
+private:
+    /**
+     * Timeline can't be copied.
+     */
+    CTTimeline(const CTTimeline &source);
+    CTTimeline &operator=(const CTTimeline &source);
+
+    /**
+     * A run of a task, ordered by time, then by indexing order.
+     */
+    class Run
+    {
+    public:
+        QDateTime time;
+        quint64 sequence;
+        CTTask *task;
+        CTCron *cron;
+
+        bool operator<(const Run &other) const;
+    };
+
+    /**
+     * An indexed task, and its first run at or after mCursor, if any.
+     */
+    class Entry
+    {
+    public:
+        CTCron *cron;
+        quint64 sequence;
+        QDateTime next;
+    };
+
+    /**
+     * Moves mCursor to @p begin, advancing the runs now before it.  Moving
+     * backward computes the next run of every task again.
+     */
+    void moveCursor(const QDateTime &begin) const;
+
+    /**
+     * Sets the next run of @p entry from mCursor, and puts it in mRuns.
+     */
+    void schedule(CTTask *task, Entry &entry) const;
+
+    void unschedule(CTTask *task, const Entry &entry) const;
+
+    QList<CTFiring> merge(const QDateTime &begin, const QDateTime &end, int count) const;
+
+    QList<CTCron *> mCrons;
+
+    /**
+     * Indexed tasks.
+     */
+    mutable QHash<CTTask *, Entry> mTasks;
+
+    /**
+     * Next run of each indexed task which runs again after mCursor.
+     */
+    mutable std::set<Run> mRuns;
+
+    /**
+     * Time the next runs are computed from, invalid until the first query.
+     */
+    mutable QDateTime mCursor;
+
+    quint64 mNextSequence = 0;
+};
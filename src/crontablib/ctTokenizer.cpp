@@ -0,0 +1,58 @@
+/*
+    CT Tokenizer Implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ctTokenizer.h"
+
+CTTokenizer::CTTokenizer(QStringView text)
+    : mText(text)
+{
+}
+
+bool CTTokenizer::isBlank(QChar character)
+{
+    return character == QLatin1Char(' ') || character == QLatin1Char('\t');
+}
+
+qsizetype CTTokenizer::indexOfBlank(QStringView text)
+{
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        if (isBlank(text.at(i))) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void CTTokenizer::skipBlanks()
+{
+    while (mPosition < mText.size() && isBlank(mText.at(mPosition))) {
+        mPosition++;
+    }
+}
+
+QStringView CTTokenizer::nextField()
+{
+    skipBlanks();
+
+    const qsizetype begin = mPosition;
+    while (mPosition < mText.size() && !isBlank(mText.at(mPosition))) {
+        mPosition++;
+    }
+
+    return mText.sliced(begin, mPosition - begin);
+}
+
+QStringView CTTokenizer::remaining()
+{
+    skipBlanks();
+
+    const QStringView rest = mText.sliced(mPosition);
+    mPosition = mText.size();
+    return rest;
+}
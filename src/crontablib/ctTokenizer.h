@@ -0,0 +1,47 @@
+/*
+    CT Tokenizer Header
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QStringView>
+
+/**
+ * Splits a crontab line into blank separated fields, in a single pass
+ * and without copying it.  Blanks are spaces and tabs, and a run of
+ * blanks separates two fields.
+ */
+class CTTokenizer
+{
+public:
+    explicit CTTokenizer(QStringView text);
+
+    /**
+     * Skips blanks, then returns the field up to the next blank, or an
+     * empty view if the end of the line has been reached.
+     */
+    QStringView nextField();
+
+    /**
+     * Skips blanks, then returns the rest of the line, such as a command.
+     */
+    QStringView remaining();
+
+    static bool isBlank(QChar character);
+
+    /**
+     * Position of the first blank in @p text, or -1.
+     */
+    static qsizetype indexOfBlank(QStringView text);
+
+private:
+    void skipBlanks();
+
+    QStringView mText;
+
+    qsizetype mPosition = 0;
+};
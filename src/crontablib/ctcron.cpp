@@ -8,54 +8,143 @@
 
 #include "ctcron.h"
 
+#include <QCryptographicHash>
 #include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QProcess>
-#include <QRegularExpression>
+#include <QSet>
 #include <QTemporaryFile>
 #include <QTextStream>
 
 #include <KLocalizedString>
 #include <KShell>
 
+// For root permissions
+#include <KAuth/Action>
+#include <KAuth/ExecuteJob>
+
+#include "ctCommandLineJob.h"
+#include "ctCronWriter.h"
 #include "ctInitializationError.h"
+#include "ctSaveJob.h"
+#include "ctTimeline.h"
+#include "cthost.h"
+#include "ctTokenizer.h"
 #include "cttask.h"
 #include "ctvariable.h"
 
-// For root permissions
-#include <KAuth/Action>
-#include <KAuth/ExecuteJob>
-#include <kauth_version.h>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <pwd.h> // pwd, getpwnam(), getpwuid()
 #include <unistd.h> // getuid(), unlink()
 
 #include "kcm_cron_debug.h"
 
-CommandLineStatus CommandLine::execute()
+/**
+ * Time given to the crontab binary to read or install a crontab, in milliseconds.
+ */
+static const int COMMAND_TIMEOUT = 30 * 1000;
+
+/**
+ * Tasks and variables of a crontab file by source text, in file order, to
+ * find the unchanged ones when it is parsed again.
+ */
+class CTCronSources
 {
-    QProcess process;
+public:
+    QHash<QString, QList<CTTask *>> tasks;
+    QHash<QString, QList<CTVariable *>> variables;
+};
+
+/**
+ * Source text of an entry, that is everything it is created from.
+ */
+static QString entrySource(const QString &comment, const QString &line)
+{
+    return comment + QLatin1Char('\n') + line;
+}
+
+/**
+ * Entries created since @p previousEntries.
+ */
+template<typename T>
+static QList<T *> createdEntries(const QList<T *> &entries, const QList<T *> &previousEntries)
+{
+    const QSet<T *> previousEntrySet(previousEntries.constBegin(), previousEntries.constEnd());
+
+    QList<T *> created;
+    for (T *entry : entries) {
+        if (!previousEntrySet.contains(entry)) {
+            created.append(entry);
+        }
+    }
 
+    return created;
+}
+
+/**
+ * Waits for @p process, running @p commandLine, to finish, killing it after COMMAND_TIMEOUT.
+ */
+static CommandLineStatus waitForCommandLine(QProcess *process, const CommandLine &commandLine)
+{
     int exitCode;
-    process.start(commandLine, parameters);
-    if (!process.waitForStarted()) {
+    if (process->waitForFinished(COMMAND_TIMEOUT)) {
+        exitCode = process->exitCode();
+    } else if (process->error() == QProcess::FailedToStart) {
         exitCode = 127;
     } else {
-        process.waitForFinished(-1);
-        exitCode = process.exitCode();
+        qCDebug(KCM_CRON_LOG) << "Command" << commandLine.commandLine << commandLine.parameters << "timed out";
+        process->kill();
+        process->waitForFinished();
+        exitCode = CommandLineStatus::TimedOut;
     }
 
     CommandLineStatus commandLineStatus;
 
-    commandLineStatus.commandLine = commandLine + QLatin1String(" ") + parameters.join(QLatin1String(" "));
+    commandLineStatus.commandLine = commandLine.commandLine + QLatin1String(" ") + commandLine.parameters.join(QLatin1String(" "));
 
-    commandLineStatus.standardOutput = QLatin1String(process.readAllStandardOutput());
-    commandLineStatus.standardError = QLatin1String(process.readAllStandardError());
+    commandLineStatus.standardOutput = QLatin1String(process->readAllStandardOutput());
+    commandLineStatus.standardError = QLatin1String(process->readAllStandardError());
     commandLineStatus.exitCode = exitCode;
 
     return commandLineStatus;
 }
 
+CommandLineStatus CommandLine::execute()
+{
+    QProcess process;
+    process.start(commandLine, parameters);
+
+    return waitForCommandLine(&process, *this);
+}
+
+QList<CommandLineStatus> CommandLine::executeAll(const QList<CommandLine> &commandLines, int maximumRunning)
+{
+    QList<CommandLineStatus> commandLineStatuses;
+    commandLineStatuses.reserve(commandLines.count());
+
+    // Started ahead, but waited for in order, without an event loop.
+    std::vector<std::unique_ptr<QProcess>> processes(commandLines.count());
+    int nextIndex = 0;
+    for (int index = 0; index < commandLines.count(); ++index) {
+        while (nextIndex < commandLines.count() && nextIndex - index < maximumRunning) {
+            const CommandLine &commandLine = commandLines.at(nextIndex);
+            processes[nextIndex] = std::make_unique<QProcess>();
+            processes[nextIndex]->start(commandLine.commandLine, commandLine.parameters);
+            nextIndex++;
+        }
+
+        commandLineStatuses.append(waitForCommandLine(processes[index].get(), commandLines.at(index)));
+        processes[index].reset();
+    }
+
+    return commandLineStatuses;
+}
+
 CTCron::CTCron(const QString &crontabBinary, const struct passwd *userInfos, bool currentUserCron, CTInitializationError &ctInitializationError)
     : d(new CTCronPrivate())
 {
@@ -67,39 +156,271 @@ CTCron::CTCron(const QString &crontabBinary, const struct passwd *userInfos, boo
 
     d->crontabBinary = crontabBinary;
 
+    if (!initializeFromUserInfos(userInfos)) {
+        ctInitializationError.setErrorMessage(i18n("No password entry found for uid '%1'", getuid()));
+        qCDebug(KCM_CRON_LOG) << "Error in crontab creation of" << userInfos->pw_name;
+        return;
+    }
+}
+
+CommandLine CTCron::readCommandLine() const
+{
     CommandLine readCommandLine;
 
     // regular user, so provide user's own crontab
-    if (currentUserCron) {
+    if (d->currentUserCron) {
         readCommandLine.commandLine = d->crontabBinary;
         readCommandLine.parameters << QStringLiteral("-l");
     } else {
         readCommandLine.commandLine = d->crontabBinary;
-        readCommandLine.parameters << QStringLiteral("-u") << QLatin1String(userInfos->pw_name) << QStringLiteral("-l");
+        readCommandLine.parameters << QStringLiteral("-u") << d->userLogin << QStringLiteral("-l");
     }
 
-    d->initialTaskCount = 0;
-    d->initialVariableCount = 0;
+    return readCommandLine;
+}
 
-    if (!initializeFromUserInfos(userInfos)) {
-        ctInitializationError.setErrorMessage(i18n("No password entry found for uid '%1'", getuid()));
-        qCDebug(KCM_CRON_LOG) << "Error in crontab creation of" << userInfos->pw_name;
+CommandLine CTCron::writeCommandLine(const QString &fileName) const
+{
+    CommandLine writeCommandLine;
+    writeCommandLine.commandLine = d->crontabBinary;
+
+    if (d->currentUserCron) {
+        writeCommandLine.parameters << fileName;
+    } else {
+        writeCommandLine.parameters << QStringLiteral("-u") << d->userLogin << fileName;
+    }
+
+    return writeCommandLine;
+}
+
+void CTCron::load()
+{
+    load(readCommandLine().execute());
+}
+
+CommandLineJob *CTCron::createLoadJob(QObject *parent)
+{
+    auto loadJob = new CommandLineJob(readCommandLine(), parent);
+    loadJob->setTimeout(COMMAND_TIMEOUT);
+
+    QObject::connect(loadJob, &KJob::result, loadJob, [this, loadJob]() {
+        // It may have been read on first use in the meantime.
+        if (!d->loaded) {
+            load(loadJob->commandLineStatus());
+        }
+    });
+
+    return loadJob;
+}
+
+void CTCron::load(const CommandLineStatus &readStatus)
+{
+    // An empty crontab would replace the actual one on next save, so it is read again on next use.
+    if (readStatus.exitCode == CommandLineStatus::TimedOut) {
+        qCDebug(KCM_CRON_LOG) << "Unable to read the crontab of" << d->userLogin << ":" << readStatus.commandLine << "timed out";
         return;
     }
 
     // Don't set error if it can't be read, it means the user doesn't have a crontab.
-    CommandLineStatus commandLineStatus = readCommandLine.execute();
-    if (commandLineStatus.exitCode == 0) {
-        QTextStream stream(&commandLineStatus.standardOutput);
+    if (readStatus.exitCode == 0) {
+        QString standardOutput = readStatus.standardOutput;
+        QTextStream stream(&standardOutput);
         parseTextStream(&stream);
     } else {
-        qCDebug(KCM_CRON_LOG) << "Error when executing command" << commandLineStatus.commandLine;
-        qCDebug(KCM_CRON_LOG) << "Standard output :" << commandLineStatus.standardOutput;
-        qCDebug(KCM_CRON_LOG) << "Standard error :" << commandLineStatus.standardError;
+        qCDebug(KCM_CRON_LOG) << "Error when executing command" << readStatus.commandLine;
+        qCDebug(KCM_CRON_LOG) << "Standard output :" << readStatus.standardOutput;
+        qCDebug(KCM_CRON_LOG) << "Standard error :" << readStatus.standardError;
+    }
+
+    finishLoading();
+}
+
+bool CTCron::loadFromSpool(const QString &spoolDirectory)
+{
+    const QFileInfo spoolFile(QDir(spoolDirectory), d->userLogin);
+
+    // Same as "crontab -l" failing: the user doesn't have a crontab.
+    if (!spoolFile.exists()) {
+        d->fileName = spoolFile.filePath();
+        finishLoading();
+        return true;
+    }
+
+    // Leave anything unusual (permissions, special files) to the crontab binary.
+    if (!spoolFile.isFile() || !spoolFile.isReadable()) {
+        return false;
+    }
+
+    if (!parseFile(spoolFile.filePath())) {
+        return false;
+    }
+
+    d->fileName = spoolFile.filePath();
+    finishLoading();
+    return true;
+}
+
+void CTCron::finishLoading()
+{
+    const bool firstLoading = !d->loaded;
+
+    d->loaded = true;
+    d->entriesAddedOrRemoved = false;
+    d->savedContentHash = contentHash();
+    d->cleanGeneration = d->generation;
+
+    if (!firstLoading) {
+        return;
+    }
+
+    // The timeline and the watcher skipped this cron until now.
+    if (d->timeline) {
+        d->timeline->refreshCron(this);
+    }
+
+    if (d->host) {
+        d->host->cronLoaded(this);
+    }
+}
+
+void CTCron::deferLoading(const QString &spoolDirectory)
+{
+    d->lazy = true;
+    d->lazySpoolDirectory = spoolDirectory;
+
+    if (!spoolDirectory.isEmpty()) {
+        d->fileName = QFileInfo(QDir(spoolDirectory), d->userLogin).filePath();
+    }
+}
+
+bool CTCron::isLazy() const
+{
+    return d->lazy;
+}
+
+bool CTCron::isLoaded() const
+{
+    return d->loaded;
+}
+
+void CTCron::ensureLoaded()
+{
+    if (d->loaded) {
+        return;
+    }
+
+    qCDebug(KCM_CRON_LOG) << "Loading crontab of" << d->userLogin << "on first use";
+
+    if (d->lazySpoolDirectory.isEmpty() || !loadFromSpool(d->lazySpoolDirectory)) {
+        load();
+    }
+}
+
+QString CTCron::fileName() const
+{
+    return d->fileName;
+}
+
+bool CTCron::reload(CTCronChanges *changes)
+{
+    // Read on first use anyway.
+    if (!d->loaded || d->fileName.isEmpty()) {
+        return false;
+    }
+
+    if (isDirty()) {
+        qCDebug(KCM_CRON_LOG) << "Not reloading the crontab of" << d->userLogin << "which has unsaved changes";
+        return false;
+    }
+
+    const QList<CTTask *> previousTasks = d->task;
+    const QList<CTVariable *> previousVariables = d->variable;
+    const QHash<CTTask *, QString> previousTaskSources = std::exchange(d->taskSources, {});
+    const QHash<CTVariable *, QString> previousVariableSources = std::exchange(d->variableSources, {});
+
+    CTCronSources previousSources;
+    for (CTTask *ctTask : previousTasks) {
+        const auto it = previousTaskSources.constFind(ctTask);
+        if (it != previousTaskSources.constEnd()) {
+            previousSources.tasks[it.value()].append(ctTask);
+        }
+    }
+
+    for (CTVariable *ctVariable : previousVariables) {
+        const auto it = previousVariableSources.constFind(ctVariable);
+        if (it != previousVariableSources.constEnd()) {
+            previousSources.variables[it.value()].append(ctVariable);
+        }
+    }
+
+    d->task.clear();
+    d->variable.clear();
+
+    // Same as "crontab -l" failing: the crontab has been removed.
+    const bool read = !QFileInfo::exists(d->fileName) || parseFile(d->fileName, &previousSources);
+
+    const QList<CTTask *> addedTasks = createdEntries(d->task, previousTasks);
+    const QList<CTVariable *> addedVariables = createdEntries(d->variable, previousVariables);
+
+    if (!read || contentHash() == d->savedContentHash) {
+        // The same entries in the same order, for instance as saved: learn their source text.
+        if (read && d->task.count() == previousTasks.count() && d->variable.count() == previousVariables.count()) {
+            QHash<CTTask *, QString> taskSources;
+            for (int i = 0; i < previousTasks.count(); ++i) {
+                taskSources.insert(previousTasks.at(i), d->taskSources.value(d->task.at(i)));
+            }
+
+            QHash<CTVariable *, QString> variableSources;
+            for (int i = 0; i < previousVariables.count(); ++i) {
+                variableSources.insert(previousVariables.at(i), d->variableSources.value(d->variable.at(i)));
+            }
+
+            d->taskSources = taskSources;
+            d->variableSources = variableSources;
+        } else {
+            d->taskSources = previousTaskSources;
+            d->variableSources = previousVariableSources;
+        }
+
+        qDeleteAll(addedTasks);
+        qDeleteAll(addedVariables);
+        d->task = previousTasks;
+        d->variable = previousVariables;
+        return false;
+    }
+
+    // The previous entries which have not been reused.
+    const QList<CTTask *> removedTasks = createdEntries(previousTasks, d->task);
+    const QList<CTVariable *> removedVariables = createdEntries(previousVariables, d->variable);
+
+    qCDebug(KCM_CRON_LOG) << "Reloading the crontab of" << d->userLogin << "from" << d->fileName << ":" << addedTasks.count() + addedVariables.count()
+                          << "new entries," << removedTasks.count() + removedVariables.count() << "removed entries";
+
+    if (d->timeline) {
+        for (CTTask *ctTask : removedTasks) {
+            d->timeline->removeTask(ctTask);
+        }
+
+        for (CTTask *ctTask : addedTasks) {
+            d->timeline->addTask(this, ctTask);
+        }
+    }
+
+    ++d->generation;
+    finishLoading();
+
+    if (changes) {
+        changes->addedTasks = addedTasks;
+        changes->addedVariables = addedVariables;
+        changes->removedTasks = removedTasks;
+        changes->removedVariables = removedVariables;
     }
 
-    d->initialTaskCount = d->task.size();
-    d->initialVariableCount = d->variable.size();
+    // Deleted last, so that new entries can't have the address of removed ones.
+    qDeleteAll(removedTasks);
+    qDeleteAll(removedVariables);
+
+    return true;
 }
 
 CTCron::CTCron()
@@ -130,7 +451,13 @@ CTCron &CTCron::operator=(const CTCron &source)
         qCDebug(KCM_CRON_LOG) << "Affect the system cron";
     }
 
+    // A const source can't be read on first use.
+    Q_ASSERT(source.isLoaded());
+
+    ensureLoaded();
+
     d->variable.clear();
+    d->variableSources.clear();
     const auto variables = source.variables();
     for (CTVariable *ctVariable : variables) {
         auto tmp = new CTVariable(*ctVariable);
@@ -138,105 +465,221 @@ CTCron &CTCron::operator=(const CTCron &source)
     }
 
     d->task.clear();
+    d->taskSources.clear();
     const auto tasks = source.tasks();
     for (CTTask *ctTask : tasks) {
         auto tmp = new CTTask(*ctTask);
         d->task.append(tmp);
     }
 
+    d->entriesAddedOrRemoved = true;
+    markModified();
+
+    if (d->timeline) {
+        d->timeline->refreshCron(this);
+    }
+
     return *this;
 }
 
-void CTCron::parseFile(const QString &fileName)
+bool CTCron::parseFile(const QString &fileName, CTCronSources *previousSources)
 {
     QFile file(fileName);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return;
+        return false;
     }
 
     QTextStream in(&file);
-    parseTextStream(&in);
+    parseTextStream(&in, true, previousSources);
+    return true;
 }
 
 void CTCron::parseTextStream(QTextStream *stream)
+{
+    parseTextStream(stream, false, nullptr);
+}
+
+void CTCron::parseTextStream(QTextStream *stream, bool keepSources, CTCronSources *previousSources)
 {
     QString comment;
     bool leadingComment = true;
 
-    while (!stream->atEnd()) {
-        QString line = stream->readLine();
+    // The line buffer is reused from one line to the next.
+    QString line;
+    while (stream->readLineInto(&line)) {
+        const QStringView lineView(line);
 
         // search for comments "#" but not disabled tasks "#\"
-        if (line.indexOf(QLatin1String("#")) == 0 && line.indexOf(QLatin1String("\\")) != 1) {
+        if (lineView.startsWith(QLatin1Char('#')) && !lineView.sliced(1).startsWith(QLatin1Char('\\'))) {
             // Skip leading comments with leading spaces, those are not written by KCron
-            if (leadingComment && line.startsWith(QLatin1String("# "))) {
+            if (leadingComment && lineView.startsWith(QLatin1String("# "))) {
                 continue;
             }
             leadingComment = false;
             // If the first 10 characters don't contain a character, it's probably a disabled entry.
-            int firstText = line.indexOf(QRegularExpression(QLatin1String("\\w")));
+            qsizetype firstText = -1;
+            for (qsizetype i = 0; i < lineView.size(); ++i) {
+                const QChar character = lineView.at(i);
+                if (character.isLetterOrNumber() || character == QLatin1Char('_')) {
+                    firstText = i;
+                    break;
+                }
+            }
             if (firstText < 0) {
                 continue;
             }
 
             if (firstText < 10) {
                 // remove leading pound sign
-                line = line.mid(1, line.length() - 1);
+                const QStringView commentLine = lineView.sliced(1).trimmed();
                 if (comment.isEmpty()) {
-                    comment = line.trimmed();
+                    comment = commentLine.toString();
                 } else {
-                    comment += QLatin1String("\n") + line.trimmed();
+                    comment += QLatin1Char('\n');
+                    comment += commentLine;
                 }
                 continue;
             }
         }
 
         // either a task or a variable
-        int firstWhiteSpace(line.indexOf(QRegularExpression(QLatin1String("[ \t]"))));
-        int firstEquals(line.indexOf(QLatin1String("=")));
+        const qsizetype firstWhiteSpace = CTTokenizer::indexOfBlank(lineView);
+        const qsizetype firstEquals = lineView.indexOf(QLatin1Char('='));
 
         // if there is an equals sign and either there is no
         // whitespace or the first whitespace is after the equals
         // sign, it must be a variable
         if ((firstEquals > 0) && ((firstWhiteSpace == -1) || firstWhiteSpace > firstEquals)) {
+            const QString source = keepSources ? entrySource(comment, line) : QString();
+
+            CTVariable *tmp = nullptr;
+            if (previousSources) {
+                QList<CTVariable *> &previousVariables = previousSources->variables[source];
+                if (!previousVariables.isEmpty()) {
+                    tmp = previousVariables.takeFirst();
+                }
+            }
+
             // create variable
-            auto tmp = new CTVariable(line, comment, d->userLogin);
+            if (tmp == nullptr) {
+                tmp = new CTVariable(line, comment, d->userLogin);
+            }
             d->variable.append(tmp);
+
+            if (keepSources) {
+                d->variableSources.insert(tmp, source);
+            }
             comment.clear();
         }
         // must be a task, either enabled or disabled
         else {
             if (firstWhiteSpace > 0) {
-                auto tmp = new CTTask(line, comment, d->userLogin, d->multiUserCron);
+                const QString source = keepSources ? entrySource(comment, line) : QString();
+
+                CTTask *tmp = nullptr;
+                if (previousSources) {
+                    QList<CTTask *> &previousTasks = previousSources->tasks[source];
+                    if (!previousTasks.isEmpty()) {
+                        tmp = previousTasks.takeFirst();
+                    }
+                }
+
+                if (tmp == nullptr) {
+                    tmp = new CTTask(line, comment, d->userLogin, d->multiUserCron);
+                }
                 d->task.append(tmp);
+
+                if (keepSources) {
+                    d->taskSources.insert(tmp, source);
+                }
                 comment.clear();
             }
         }
     }
 }
 
-QString CTCron::exportCron() const
+/**
+ * Approximate length of the crontab format of the given entries, so that
+ * the export can be reserved at once.
+ */
+static qsizetype exportSizeHint(const QList<CTVariable *> &variables, const QList<CTTask *> &tasks)
 {
-    QString exportCron;
+    // Comment marks, scheduling, separators and line ends.
+    const qsizetype variableOverhead = 8;
+    const qsizetype taskOverhead = 40;
+    const qsizetype footer = 80;
+
+    qsizetype size = footer;
+    for (const CTVariable *ctVariable : variables) {
+        size += ctVariable->comment.size() + ctVariable->variable.size() + ctVariable->value.size() + variableOverhead;
+    }
 
-    for (CTVariable *ctVariable : std::as_const(d->variable)) {
-        exportCron += ctVariable->exportVariable();
-        exportCron += QLatin1String("\n");
+    for (const CTTask *ctTask : tasks) {
+        size += ctTask->comment.size() + ctTask->userLogin.size() + ctTask->command.size() + taskOverhead;
     }
 
-    for (CTTask *ctTask : std::as_const(d->task)) {
-        exportCron += ctTask->exportTask();
-        exportCron += QLatin1String("\n");
+    return size;
+}
+
+/**
+ * Writes the entries of a cron.
+ */
+static void writeEntries(CTCronWriter &writer, const QList<CTVariable *> &variables, const QList<CTTask *> &tasks)
+{
+    for (const CTVariable *ctVariable : variables) {
+        ctVariable->writeVariable(writer);
+        writer << QLatin1Char('\n');
     }
 
-    exportCron += QLatin1String("\n");
+    for (const CTTask *ctTask : tasks) {
+        ctTask->writeTask(writer);
+        writer << QLatin1Char('\n');
+    }
+}
+
+/**
+ * Writes the KCron generation message, which ends saved crons.
+ */
+static void writeGenerationMessage(CTCronWriter &writer)
+{
+    writer << QLatin1Char('\n');
     QString exportInfo =
         i18nc("Generation Message + current date", "File generated by KCron the %1.", QDateTime::currentDateTime().toString(QLocale().dateTimeFormat()));
-    exportCron += QLatin1String("# ") + exportInfo + QLatin1String("\n");
+    writer << QLatin1String("# ") << exportInfo << QLatin1Char('\n');
+}
+
+QString CTCron::exportCron() const
+{
+    QString exportCron;
+
+    CTCronWriter writer(&exportCron, exportSizeHint(d->variable, d->task));
+    writeEntries(writer, d->variable, d->task);
+    writeGenerationMessage(writer);
 
     return exportCron;
 }
 
+bool CTCron::writeCron(QIODevice *device) const
+{
+    CTCronWriter writer(device, exportSizeHint(d->variable, d->task));
+    writeEntries(writer, d->variable, d->task);
+    writeGenerationMessage(writer);
+
+    return writer.flush();
+}
+
+QByteArray CTCron::contentHash() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    {
+        CTCronWriter writer(&hash);
+        writeEntries(writer, d->variable, d->task);
+    }
+
+    return hash.result();
+}
+
 CTCron::~CTCron()
 {
     qDeleteAll(d->task);
@@ -264,6 +707,8 @@ CTSaveStatus CTCron::prepareSaveStatusError(const CommandLineStatus &commandLine
     QString detailError;
     if (commandLineStatus.exitCode == 127) {
         detailError = i18n("<p><strong>Command:</strong> %1</p><strong>Command could not be started</strong>", commandLineStatus.commandLine);
+    } else if (commandLineStatus.exitCode == CommandLineStatus::TimedOut) {
+        detailError = i18n("<p><strong>Command:</strong> %1</p><strong>Command did not finish in time</strong>", commandLineStatus.commandLine);
     } else {
         detailError = i18n("<p><strong>Command:</strong> %1</p><strong>Standard Output :</strong><pre>%2</pre><strong>Error Output :</strong><pre>%3</pre>",
                            commandLineStatus.commandLine,
@@ -276,27 +721,36 @@ CTSaveStatus CTCron::prepareSaveStatusError(const CommandLineStatus &commandLine
 
 CTSaveStatus CTCron::save()
 {
+    ensureLoaded();
+    const QByteArray savedContentHash = contentHash();
+    if (savedContentHash == d->savedContentHash) {
+        qCDebug(KCM_CRON_LOG) << "Content of the crontab of" << d->userLogin << "did not change, not saving it";
+        markSaved(savedContentHash);
+        return CTSaveStatus();
+    }
+
     // write to temp file
     QTemporaryFile tmp;
     if (!tmp.open()) {
         return CTSaveStatus(i18n("Unable to open crontab file for writing"), i18n("The file %1 could not be opened.", tmp.fileName()));
     }
 
-    {
-        QTextStream out(&tmp);
-        out << exportCron();
-        out.flush();
+    if (!writeCron(&tmp)) {
+        return CTSaveStatus(i18n("Unable to open crontab file for writing"), i18n("The file %1 could not be written.", tmp.fileName()));
     }
     tmp.close();
 
     // For root permissions.
     if (d->systemCron) {
-        qCDebug(KCM_CRON_LOG) << "Attempting to save system cron";
+        qCDebug(KCM_CRON_LOG) << "Attempting to save system cron" << d->fileName;
         QVariantMap args;
         args.insert(QStringLiteral("source"), tmp.fileName());
+        args.insert(QStringLiteral("target"), d->fileName);
         KAuth::Action saveAction(QStringLiteral("local.kcron.crontab.save"));
         saveAction.setHelperId(QStringLiteral("local.kcron.crontab"));
         saveAction.setArguments(args);
+
+        // KAuth can only be waited for from an event loop, see createSaveJob() to avoid it.
         KAuth::ExecuteJob *job = saveAction.execute();
         if (!job->exec())
             qCDebug(KCM_CRON_LOG) << "KAuth returned an error: " << job->error() << job->errorText();
@@ -308,21 +762,23 @@ CTSaveStatus CTCron::save()
     else {
         qCDebug(KCM_CRON_LOG) << "Attempting to save user cron";
         // Save without root permissions.
-        CommandLine writeCommandLine;
-        writeCommandLine.commandLine = d->crontabBinary;
-        if (d->currentUserCron) {
-            writeCommandLine.parameters << tmp.fileName();
-        } else {
-            writeCommandLine.parameters << QStringLiteral("-u") << d->userLogin << tmp.fileName();
-        }
-
-        const CommandLineStatus commandLineStatus = writeCommandLine.execute();
+        const CommandLineStatus commandLineStatus = writeCommandLine(tmp.fileName()).execute();
         if (commandLineStatus.exitCode != 0) {
             return prepareSaveStatusError(commandLineStatus);
         }
     }
+    markSaved(savedContentHash);
+    qCDebug(KCM_CRON_LOG) << "All saved";
+    return CTSaveStatus();
+}
 
-    // Mark as applied
+CTSaveJob *CTCron::createSaveJob(QObject *parent)
+{
+    return new CTSaveJob(QList<CTCron *>{this}, parent);
+}
+
+void CTCron::apply()
+{
     for (CTTask *ctTask : std::as_const(d->task)) {
         ctTask->apply();
     }
@@ -331,14 +787,29 @@ CTSaveStatus CTCron::save()
         ctVariable->apply();
     }
 
-    d->initialTaskCount = d->task.size();
-    d->initialVariableCount = d->variable.size();
-    qCDebug(KCM_CRON_LOG) << "All saved";
-    return CTSaveStatus();
+    d->entriesAddedOrRemoved = false;
+
+    markClean();
+}
+
+QByteArray CTCron::savedContentHash() const
+{
+    return d->savedContentHash;
+}
+
+void CTCron::markSaved(const QByteArray &contentHash)
+{
+    d->savedContentHash = contentHash;
+    apply();
 }
 
 void CTCron::cancel()
 {
+    // Nothing to cancel, and nothing worth reading.
+    if (!d->loaded) {
+        return;
+    }
+
     const auto tasks = d->task;
     for (CTTask *ctTask : tasks) {
         ctTask->cancel();
@@ -348,31 +819,54 @@ void CTCron::cancel()
     for (CTVariable *ctVariable : variables) {
         ctVariable->cancel();
     }
+
+    if (d->timeline) {
+        d->timeline->refreshCron(this);
+    }
+
+    // Added and removed entries are not restored.  Comparing counts or pointers is not
+    // enough, a removed entry may be replaced by an added one at the same address.
+    if (!d->entriesAddedOrRemoved) {
+        markClean();
+    }
 }
 
 bool CTCron::isDirty() const
 {
-    if (d->initialTaskCount != d->task.count()) {
-        return true;
-    }
+    // Nothing could have been changed before the crontab was read.
+    return d->loaded && d->generation != d->cleanGeneration;
+}
 
-    if (d->initialVariableCount != d->variable.count()) {
-        return true;
-    }
+quint64 CTCron::generation() const
+{
+    return d->generation;
+}
 
-    for (CTTask *ctTask : std::as_const(d->task)) {
-        if (ctTask->dirty()) {
-            return true;
-        }
+void CTCron::markModified()
+{
+    const bool wasDirty = isDirty();
+
+    ++d->generation;
+
+    if (!wasDirty && isDirty() && d->host) {
+        d->host->cronDirtyChanged(this, true);
     }
+}
 
-    for (CTVariable *ctVariable : std::as_const(d->variable)) {
-        if (ctVariable->dirty()) {
-            return true;
-        }
+void CTCron::markClean()
+{
+    const bool wasDirty = isDirty();
+
+    d->cleanGeneration = d->generation;
+
+    if (wasDirty && d->host) {
+        d->host->cronDirtyChanged(this, false);
     }
+}
 
-    return false;
+void CTCron::setHost(CTHost *host)
+{
+    d->host = host;
 }
 
 QString CTCron::path() const
@@ -400,6 +894,8 @@ QList<CTVariable *> CTCron::variables() const
 
 void CTCron::addTask(CTTask *task)
 {
+    ensureLoaded();
+
     if (isSystemCron()) {
         task->setSystemCrontab(true);
     } else {
@@ -410,10 +906,18 @@ void CTCron::addTask(CTTask *task)
     qCDebug(KCM_CRON_LOG) << "Adding task" << task->comment << " user : " << task->userLogin;
 
     d->task.append(task);
+    d->entriesAddedOrRemoved = true;
+    markModified();
+
+    if (d->timeline) {
+        d->timeline->addTask(this, task);
+    }
 }
 
 void CTCron::addVariable(CTVariable *variable)
 {
+    ensureLoaded();
+
     if (isSystemCron()) {
         variable->userLogin = QStringLiteral("root");
     } else {
@@ -423,26 +927,45 @@ void CTCron::addVariable(CTVariable *variable)
     qCDebug(KCM_CRON_LOG) << "Adding variable" << variable->variable << " user : " << variable->userLogin;
 
     d->variable.append(variable);
+    d->entriesAddedOrRemoved = true;
+    markModified();
 }
 
-void CTCron::modifyTask(CTTask * /*task*/)
+void CTCron::modifyTask(CTTask *task)
 {
-    // Nothing to do specifically when modifying a task
+    // It does not match its source text anymore.
+    d->taskSources.remove(task);
+    markModified();
+
+    if (d->timeline) {
+        d->timeline->modifyTask(task);
+    }
 }
 
-void CTCron::modifyVariable(CTVariable * /*variable*/)
+void CTCron::modifyVariable(CTVariable *variable)
 {
-    // Nothing to do specifically when modifying a variable
+    d->variableSources.remove(variable);
+    markModified();
 }
 
 void CTCron::removeTask(CTTask *task)
 {
     d->task.removeAll(task);
+    d->taskSources.remove(task);
+    d->entriesAddedOrRemoved = true;
+    markModified();
+
+    if (d->timeline) {
+        d->timeline->removeTask(task);
+    }
 }
 
 void CTCron::removeVariable(CTVariable *variable)
 {
     d->variable.removeAll(variable);
+    d->variableSources.remove(variable);
+    d->entriesAddedOrRemoved = true;
+    markModified();
 }
 
 bool CTCron::isMultiUserCron() const
@@ -469,3 +992,8 @@ QString CTCron::userRealName() const
 {
     return d->userRealName;
 }
+
+void CTCron::setTimeline(CTTimeline *timeline)
+{
+    d->timeline = timeline;
+}
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QStringList>
@@ -15,8 +17,15 @@
 class CTTask;
 class CTVariable;
 class CTInitializationError;
+class CTTimeline;
+class CTHost;
+class CTSaveJob;
+class CTCronSources;
+class CommandLineJob;
 
 class QFile;
+class QIODevice;
+class QObject;
 class QTextStream;
 
 struct passwd;
@@ -26,6 +35,13 @@ struct passwd;
 class CommandLineStatus
 {
 public:
+    enum {
+        /**
+         * Exit code of a command killed because it did not finish in time.
+         */
+        TimedOut = -1,
+    };
+
     int exitCode;
 
     QString commandLine;
@@ -41,7 +57,36 @@ public:
 
     QStringList parameters;
 
+    /**
+     * Runs the command line, waiting for it to finish, without an event
+     * loop.  A command not finished within 30 seconds is killed, with a
+     * TimedOut exit code.
+     * See CommandLineJob to run it without blocking the event loop.
+     */
     CommandLineStatus execute();
+
+    /**
+     * Runs the command lines concurrently, at most @p maximumRunning at a
+     * time, waiting for them like execute().
+     * Returns the statuses in the same order as @p commandLines.
+     */
+    static QList<CommandLineStatus> executeAll(const QList<CommandLine> &commandLines, int maximumRunning);
+};
+
+/**
+ * Tasks and variables replaced by CTCron::reload().
+ */
+class CTCronChanges
+{
+public:
+    QList<CTTask *> addedTasks;
+    QList<CTVariable *> addedVariables;
+
+    /**
+     * Already deleted, only given to be forgotten.
+     */
+    QList<CTTask *> removedTasks;
+    QList<CTVariable *> removedVariables;
 };
 
 class CTCronPrivate
@@ -84,13 +129,65 @@ public:
      */
     QList<CTVariable *> variable;
 
-    int initialTaskCount;
-    int initialVariableCount;
+    /**
+     * Indicates whether tasks or variables have been added or removed since
+     * the crontab was read or last saved, which cancel() can't undo.
+     */
+    bool entriesAddedOrRemoved = false;
 
     /**
      * Contains path to the crontab binary file.
      */
     QString crontabBinary;
+
+    /**
+     * Timeline notified of task changes, if any.
+     */
+    CTTimeline *timeline = nullptr;
+
+    /**
+     * Hash of the entries as read or last saved, see CTCron::contentHash().
+     */
+    QByteArray savedContentHash;
+
+    /**
+     * Host told when the cron becomes dirty or clean, if any.
+     */
+    CTHost *host = nullptr;
+
+    /**
+     * Count of changes made to the tasks and variables, and its value
+     * when they were read, last saved or cancelled.
+     */
+    quint64 generation = 0;
+    quint64 cleanGeneration = 0;
+
+    /**
+     * Indicates whether or not the crontab has been read.
+     */
+    bool loaded = false;
+
+    /**
+     * Indicates whether or not the crontab is only read on first use.
+     */
+    bool lazy = false;
+
+    /**
+     * Spool directory to read the crontab from on first use, if any.
+     */
+    QString lazySpoolDirectory;
+
+    /**
+     * File the crontab is read from directly, if any.
+     */
+    QString fileName;
+
+    /**
+     * Source text of the unmodified tasks and variables read from
+     * fileName(), to keep them when it is reloaded.
+     */
+    QHash<CTTask *, QString> taskSources;
+    QHash<CTVariable *, QString> variableSources;
 };
 
 /**
@@ -103,6 +200,8 @@ public:
     /**
      * If you already have a struct passwd, use it instead.
      * This is never used for the system crontab.
+     *
+     * The crontab is not read yet, call load() to do it.
      */
     explicit CTCron(const QString &cronBinary, const struct passwd *userInfos, bool currentUserCron, CTInitializationError &ctInitializationError);
 
@@ -116,8 +215,14 @@ public:
      */
     CTCron &operator=(const CTCron &source);
 
+    /**
+     * Tasks of the crontab, empty until it has been read, see isLoaded().
+     */
     virtual QList<CTTask *> tasks() const;
 
+    /**
+     * Variables of the crontab, empty until it has been read, see isLoaded().
+     */
     virtual QList<CTVariable *> variables() const;
 
     virtual void addTask(CTTask *task);
@@ -129,26 +234,163 @@ public:
     virtual void removeVariable(CTVariable *variable);
     virtual void removeTask(CTTask *task);
 
+    /**
+     * Command line printing the user's crontab.
+     */
+    CommandLine readCommandLine() const;
+
+    /**
+     * Command line installing @p fileName as the user's crontab.
+     */
+    CommandLine writeCommandLine(const QString &fileName) const;
+
+    /**
+     * Reads the crontab by running readCommandLine(), waiting for it
+     * without an event loop.
+     */
+    void load();
+
+    /**
+     * Job reading the crontab by running readCommandLine(), without
+     * blocking the event loop.  The job is not started.
+     *
+     * The crontab is parsed once the job finished, unless it timed out or
+     * was killed, which leaves the crontab unread.  The cron must outlive
+     * the job.
+     */
+    CommandLineJob *createLoadJob(QObject *parent = nullptr);
+
+    /**
+     * Parses the result of readCommandLine(), which may have been run
+     * along with the ones of other crons.  The crontab stays unread if the
+     * command timed out.
+     */
+    void load(const CommandLineStatus &readStatus);
+
+    /**
+     * Reads the crontab directly from the cron daemon spool directory
+     * (e.g. /var/spool/cron/crontabs), without running the crontab binary.
+     * The spool directory must be searchable, otherwise a missing crontab
+     * can't be told apart from an unreadable one.
+     *
+     * Returns false if the spool file exists but can't be read, load()
+     * must then be used instead.
+     */
+    bool loadFromSpool(const QString &spoolDirectory);
+
+    /**
+     * Only read the crontab when asked to, with ensureLoaded() or
+     * createLoadJob(), or when it is first modified.  ensureLoaded() reads it
+     * from @p spoolDirectory if possible, or with the crontab binary.
+     *
+     * Until then, tasks(), variables() and the functions based on them see
+     * an empty crontab.
+     */
+    void deferLoading(const QString &spoolDirectory);
+
+    /**
+     * Returns true if the crontab is only read on first use.
+     */
+    bool isLazy() const;
+
+    /**
+     * Returns true once the crontab has been read.
+     */
+    bool isLoaded() const;
+
+    /**
+     * Reads a lazy crontab now, if it has not been read yet, waiting for it
+     * without an event loop.
+     */
+    void ensureLoaded();
+
+    /**
+     * File the crontab is read from directly, as the system crontab or a
+     * spool file, or an empty string if it is read with the crontab binary.
+     */
+    QString fileName() const;
+
+    /**
+     * Reads the crontab again from fileName(), after it changed on disk.
+     * Tasks and variables whose lines did not change are kept, the others
+     * are deleted and replaced by new ones, which @p changes lists.
+     *
+     * Nothing is done if the crontab has not been read yet, or is dirty,
+     * since its unsaved changes will replace the file on save, or if the
+     * content of the file is the same as the one read or last saved.
+     *
+     * Returns true if tasks or variables were replaced.
+     */
+    bool reload(CTCronChanges *changes = nullptr);
+
     /**
      * Tokenizes to crontab file format.
      */
     QString exportCron() const;
 
+    /**
+     * Writes the crontab format of this cron to @p device, in UTF-8,
+     * without building the whole text in memory.
+     * Returns false if writing failed.
+     */
+    bool writeCron(QIODevice *device) const;
+
+    /**
+     * Hash of the crontab format of the entries, without the generation
+     * message, to find out whether saving would change anything.
+     */
+    QByteArray contentHash() const;
+
     /**
      * Apply changes.
+     * Does not rewrite the crontab if its content is the same as when it was
+     * read or last saved.
+     *
+     * User crontabs are installed without an event loop, but the system ones
+     * are installed by waiting for KAuth from a local event loop.
      */
     CTSaveStatus save();
 
+    /**
+     * Job applying changes like save(), without blocking the event loop.
+     * The job is not started.
+     */
+    CTSaveJob *createSaveJob(QObject *parent = nullptr);
+
+    /**
+     * Hash of the entries as read or last saved, see contentHash().
+     */
+    QByteArray savedContentHash() const;
+
+    /**
+     * Marks the changes of the tasks and variables as applied, once entries
+     * whose hash is @p contentHash have been installed as the crontab.
+     */
+    void markSaved(const QByteArray &contentHash);
+
+    /**
+     * Error of a command which failed to install the crontab.
+     */
+    CTSaveStatus prepareSaveStatusError(const CommandLineStatus &commandLineStatus);
+
     /**
      * Cancel changes.
      */
     void cancel();
 
     /**
-     * Indicates whether or not dirty.
+     * Indicates whether or not dirty, that is whether tasks or variables
+     * have been added, modified or removed since the crontab was read or
+     * last saved.  Tasks and variables report their changes through
+     * addTask(), modifyTask(), removeTask() and their variable counterparts.
      */
     bool isDirty() const;
 
+    /**
+     * Count of changes made to the tasks and variables of this cron.
+     */
+    quint64 generation() const;
+
     /**
      * Returns the PATH environment variable value.
      * A short cut to iterating the tasks vector.
@@ -172,6 +414,16 @@ public:
 
     QString userLogin() const;
 
+    /**
+     * Timeline to keep up to date when tasks are added, modified or removed.
+     */
+    void setTimeline(CTTimeline *timeline);
+
+    /**
+     * Host to tell when this cron becomes dirty or clean.
+     */
+    void setHost(CTHost *host);
+
     /**
      * TODO
      * Bugged method for the moment (need to parse x,x,x,x data from /etc/passwd).
@@ -193,14 +445,38 @@ private:
      */
     CTCron(const CTCron &source);
 
+    /**
+     * Mark changes of the tasks and variables as applied.
+     */
+    void apply();
+
+    /**
+     * Counts a change, and tells the host if the cron becomes dirty.
+     */
+    void markModified();
+
+    /**
+     * Forgets about changes, and tells the host if the cron becomes clean.
+     */
+    void markClean();
+
 protected:
     /**
-     * Parses crontab file format.
+     * Parses crontab file format, keeping the source text of the entries.
+     * The tasks and variables of @p previousSources with the same source
+     * text are used instead of new ones.
+     * Returns false if the file can't be opened.
      */
-    void parseFile(const QString &fileName);
+    bool parseFile(const QString &fileName, CTCronSources *previousSources = nullptr);
     void parseTextStream(QTextStream *stream);
+    void parseTextStream(QTextStream *stream, bool keepSources, CTCronSources *previousSources);
+
+    /**
+     * Marks the crontab as read, with the tasks and variables parsed so far
+     * as its initial content.
+     */
+    void finishLoading();
 
-    CTSaveStatus prepareSaveStatusError(const CommandLineStatus &commandLineStatus);
     // d probably stands for data.
     CTCronPrivate *const d;
 };
@@ -13,31 +13,50 @@
 #include <sys/types.h>
 #include <unistd.h> // getuid()
 
-#include <QFile>
-#include <QTextStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
+
+#include <algorithm>
 
 #include <KLocalizedString>
 
-#include "crontabWidget.h"
 
+#include "ctCronWatcher.h"
 #include "ctInitializationError.h"
+#include "ctSaveJob.h"
 #include "ctSystemCron.h"
+#include "ctTimeline.h"
 #include "ctcron.h"
 
 #include "kcm_cron_debug.h"
 
-CTHost::CTHost(const QString &cronBinary, CTInitializationError &ctInitializationError)
+CTHost::CTHost(const QString &cronBinary,
+               CTInitializationError &ctInitializationError,
+               const QString &spoolDirectory,
+               bool lazyLoading,
+               const QString &systemDirectory)
 {
     struct passwd *userInfos = nullptr;
 
     mCrontabBinary = cronBinary;
+    mLazyLoading = lazyLoading;
+    mSystemDirectory = systemDirectory;
+
+    // The spool directory is usually only searchable by root.
+    if (!spoolDirectory.isEmpty()) {
+        const QFileInfo spoolDirectoryInfo(spoolDirectory);
+        if (spoolDirectoryInfo.isDir() && spoolDirectoryInfo.isReadable() && spoolDirectoryInfo.isExecutable()) {
+            mSpoolDirectory = spoolDirectory;
+        }
+    }
 
     // If it is the root user
     if (getuid() == 0) {
         // Read /etc/passwd
         setpwent(); // restart
         while ((userInfos = getpwent())) {
-            if (allowDeny(userInfos->pw_name)) {
+            if (mAccessControl.isAllowed(QLatin1String(userInfos->pw_name))) {
                 const QString errorMessage = createCTCron(userInfos);
                 if (!errorMessage.isEmpty()) {
                     ctInitializationError.setErrorMessage(errorMessage);
@@ -47,6 +66,8 @@ CTHost::CTHost(const QString &cronBinary, CTInitializationError &ctInitializatio
             // delete userInfos;
         }
         setpwent(); // restart again for others
+
+        loadCrons();
     }
     // Non-root user, so just create user's cron table.
     else {
@@ -54,7 +75,7 @@ CTHost::CTHost(const QString &cronBinary, CTInitializationError &ctInitializatio
         unsigned int uid = getuid();
         setpwent(); // restart
         while ((userInfos = getpwent())) {
-            if ((userInfos->pw_uid == uid) && (!allowDeny(userInfos->pw_name))) {
+            if ((userInfos->pw_uid == uid) && (!mAccessControl.isAllowed(QLatin1String(userInfos->pw_name)))) {
                 ctInitializationError.setErrorMessage(
                     i18n("You have been blocked from using KCron\
 	                      by either the /etc/cron.allow file or the /etc/cron.deny file.\
@@ -75,62 +96,78 @@ CTHost::CTHost(const QString &cronBinary, CTInitializationError &ctInitializatio
             return;
         }
 
+        loadCrons();
+
         // delete currentUserPassword;
     }
-    // Create the system cron table.
-    createSystemCron();
+    // Create the system cron tables.
+    createSystemCrons();
+
+    // Lazy crontabs are watched once they have been read, see cronLoaded().
+    mWatcher = new CTCronWatcher();
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (ctCron->isLoaded()) {
+            mWatcher->watchCron(ctCron);
+        }
+    }
+
+    // Fragments are added to or removed from cron.d without changing any watched crontab.
+    mWatcher->watchDirectory(QDir(mSystemDirectory).filePath(QStringLiteral("cron.d")));
+    QObject::connect(mWatcher, &CTCronWatcher::watchedDirectoryChanged, mWatcher, [this]() {
+        refreshSystemCrons();
+    });
 }
 
 CTHost::~CTHost()
 {
+    delete mWatcher;
+    delete mTimeline;
     qDeleteAll(mCrons);
 }
 
-bool CTHost::allowDeny(char *name)
+CTAccessControl *CTHost::accessControl()
 {
-    QFile allow(QStringLiteral("/etc/cron.allow"));
+    return &mAccessControl;
+}
 
-    // if cron.allow exists make sure user is listed
-    if (allow.open(QFile::ReadOnly)) {
-        QTextStream stream(&allow);
-        while (!stream.atEnd()) {
-            if (stream.readLine() == QLatin1String(name)) {
-                allow.close();
-                return true;
-            }
+CTSaveStatus CTHost::save(CTCron *ctCron)
+{
+    qCDebug(KCM_CRON_LOG) << "Save current cron.";
+    // The cron could either be a user cron or a system cron.
+    // Implements system cron entry point.
+    return ctCron->save();
+}
+
+CTSaveStatus CTHost::save()
+{
+    qCDebug(KCM_CRON_LOG) << "Save all crons.";
+
+    // Each cron is saved even if another one can't be, the first error is reported.
+    CTSaveStatus saveStatus;
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (!ctCron->isLoaded()) {
+            continue;
         }
-        allow.close();
-        return false;
-    } else {
-        allow.close();
-        QFile deny(QStringLiteral("/etc/cron.deny"));
-
-        // else if cron.deny exists make sure user is not listed
-        if (deny.open(QFile::ReadOnly)) {
-            QTextStream stream(&deny);
-            while (!stream.atEnd()) {
-                if (stream.readLine() == QLatin1String(name)) {
-                    deny.close();
-                    return false;
-                }
-            }
-            deny.close();
-            return true;
-        } else {
-            deny.close();
-            return true;
+
+        const CTSaveStatus cronSaveStatus = ctCron->save();
+        if (cronSaveStatus.isError() && !saveStatus.isError()) {
+            saveStatus = cronSaveStatus;
         }
     }
+
+    return saveStatus;
 }
 
-CTSaveStatus CTHost::save(CrontabWidget *mCrontabWidget)
+CTSaveJob *CTHost::createSaveJob(QObject *parent)
 {
-    qCDebug(KCM_CRON_LOG) << "Save current cron.";
-    // Retrieve the current cron to use. This could either be a user cron or a system cron.
-    // Implements system cron entry point.
-    CTCron *ctCron = mCrontabWidget->currentCron();
+    QList<CTCron *> loadedCrons;
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (ctCron->isLoaded()) {
+            loadedCrons.append(ctCron);
+        }
+    }
 
-    return ctCron->save();
+    return new CTSaveJob(loadedCrons, parent);
 }
 
 void CTHost::cancel()
@@ -142,24 +179,122 @@ void CTHost::cancel()
 
 bool CTHost::isDirty()
 {
-    bool isDirty = false;
+    return mDirtyCronCount > 0;
+}
 
-    for (CTCron *ctCron : std::as_const(mCrons)) {
-        if (ctCron->isDirty()) {
-            isDirty = true;
+void CTHost::cronDirtyChanged(CTCron *ctCron, bool dirty)
+{
+    qCDebug(KCM_CRON_LOG) << "Cron of" << ctCron->userLogin() << (dirty ? "is now dirty" : "is now clean");
+
+    mDirtyCronCount += dirty ? 1 : -1;
+}
+
+void CTHost::cronLoaded(CTCron *ctCron)
+{
+    // Crons read while the host is created are watched all at once.
+    if (mWatcher) {
+        mWatcher->watchCron(ctCron);
+    }
+}
+
+/**
+ * Fragments of the cron.d directory of @p systemDirectory which cron reads.
+ */
+static QStringList findSystemCronFragments(const QString &systemDirectory)
+{
+    // Package manager leftovers and editor backups are ignored by cron.
+    static const QStringList ignoredSuffixes{QStringLiteral("~"),
+                                             QStringLiteral(".dpkg-old"),
+                                             QStringLiteral(".dpkg-new"),
+                                             QStringLiteral(".dpkg-dist"),
+                                             QStringLiteral(".rpmsave"),
+                                             QStringLiteral(".rpmnew"),
+                                             QStringLiteral(".swp")};
+
+    QStringList fragments;
+
+    // Hidden files are not listed.
+    const QDir fragmentDirectory(QDir(systemDirectory).filePath(QStringLiteral("cron.d")));
+    const QFileInfoList fragmentInfos = fragmentDirectory.entryInfoList(QDir::Files, QDir::Name);
+    for (const QFileInfo &fragmentInfo : fragmentInfos) {
+        const QString fileName = fragmentInfo.fileName();
+        const bool ignored = std::any_of(ignoredSuffixes.constBegin(), ignoredSuffixes.constEnd(), [&fileName](const QString &suffix) {
+            return fileName.endsWith(suffix);
+        });
+
+        // An unreadable fragment would be saved empty.
+        if (ignored || !fragmentInfo.isReadable()) {
+            continue;
         }
+
+        fragments.append(fragmentInfo.filePath());
     }
 
-    return isDirty;
+    return fragments;
 }
 
-CTCron *CTHost::createSystemCron()
+void CTHost::createSystemCrons()
 {
-    CTCron *p = new CTSystemCron(mCrontabBinary);
+    const QStringList fileNames = QStringList{systemCrontab()} + findSystemCronFragments(mSystemDirectory);
 
-    mCrons.append(p);
+    for (const QString &fileName : fileNames) {
+        auto ctCron = new CTSystemCron(mCrontabBinary, fileName);
+        ctCron->setHost(this);
+        mCrons.append(ctCron);
+    }
+}
+
+QString CTHost::systemCrontab() const
+{
+    return QDir(mSystemDirectory).filePath(QStringLiteral("crontab"));
+}
+
+void CTHost::refreshSystemCrons()
+{
+    const QStringList fragments = findSystemCronFragments(mSystemDirectory);
+
+    // Removed fragments with unsaved changes are kept, saving them creates them again.
+    for (auto it = mCrons.begin(); it != mCrons.end();) {
+        CTCron *ctCron = *it;
+        if (!ctCron->isSystemCron() || ctCron->fileName() == systemCrontab() || fragments.contains(ctCron->fileName()) || ctCron->isDirty()) {
+            ++it;
+            continue;
+        }
+
+        qCDebug(KCM_CRON_LOG) << "System crontab fragment" << ctCron->fileName() << "removed";
+
+        if (mWatcher) {
+            mWatcher->unwatchCron(ctCron);
+        }
+        if (mTimeline) {
+            mTimeline->removeCron(ctCron);
+        }
+
+        delete ctCron;
+        it = mCrons.erase(it);
+    }
+
+    for (const QString &fragment : fragments) {
+        const bool known = std::any_of(mCrons.constBegin(), mCrons.constEnd(), [&fragment](CTCron *ctCron) {
+            return ctCron->isSystemCron() && ctCron->fileName() == fragment;
+        });
+        if (known) {
+            continue;
+        }
+
+        qCDebug(KCM_CRON_LOG) << "System crontab fragment" << fragment << "created";
 
-    return p;
+        auto ctCron = new CTSystemCron(mCrontabBinary, fragment);
+        ctCron->setHost(this);
+        mCrons.append(ctCron);
+
+        if (mWatcher) {
+            mWatcher->watchCron(ctCron);
+        }
+        if (mTimeline) {
+            mTimeline->addCron(ctCron);
+        }
+    }
 }
 
 QString CTHost::createCTCron(const struct passwd *userInfos)
@@ -176,11 +311,49 @@ QString CTHost::createCTCron(const struct passwd *userInfos)
         return ctInitializationError.errorMessage();
     }
 
+    // Only the current user's cron is displayed at startup.
+    if (mLazyLoading && !currentUserCron) {
+        p->deferLoading(mSpoolDirectory);
+    }
+
+    p->setHost(this);
     mCrons.append(p);
 
     return QString();
 }
 
+void CTHost::loadCrons()
+{
+    QList<CTCron *> commandLineCrons;
+    QList<CommandLine> readCommandLines;
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (ctCron->isLoaded() || ctCron->isLazy()) {
+            continue;
+        }
+
+        if (!mSpoolDirectory.isEmpty() && ctCron->loadFromSpool(mSpoolDirectory)) {
+            continue;
+        }
+
+        commandLineCrons.append(ctCron);
+        readCommandLines.append(ctCron->readCommandLine());
+    }
+
+    if (readCommandLines.isEmpty()) {
+        return;
+    }
+
+    // Reading a crontab mostly waits for the crontab binary and NSS, so run more
+    // commands than there are cores.
+    const int maximumRunning = qMax(2, QThread::idealThreadCount() * 2);
+    const QList<CommandLineStatus> readStatuses = CommandLine::executeAll(readCommandLines, maximumRunning);
+
+    // Statuses are in the crons order, so the result does not depend on which process ends first.
+    for (int i = 0; i < commandLineCrons.count(); ++i) {
+        commandLineCrons.at(i)->load(readStatuses.at(i));
+    }
+}
+
 CTCron *CTHost::findCurrentUserCron() const
 {
     // Because multiple users may exist, return only the currently logged in user's cron in user cron mode.
@@ -207,6 +380,42 @@ CTCron *CTHost::findSystemCron() const
     return nullptr;
 }
 
+CTCron *CTHost::findSystemCron(const QString &fileName) const
+{
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (ctCron->isSystemCron() && ctCron->fileName() == fileName) {
+            return ctCron;
+        }
+    }
+
+    qCDebug(KCM_CRON_LOG) << "Unable to find the system Cron of" << fileName;
+    return nullptr;
+}
+
+QList<CTCron *> CTHost::systemCrons() const
+{
+    QList<CTCron *> systemCrons;
+    for (CTCron *ctCron : std::as_const(mCrons)) {
+        if (ctCron->isSystemCron()) {
+            systemCrons.append(ctCron);
+        }
+    }
+
+    // Fragments created later are appended to mCrons.
+    const QString crontab = systemCrontab();
+    std::stable_sort(systemCrons.begin(), systemCrons.end(), [&crontab](CTCron *first, CTCron *second) {
+        const bool firstIsCrontab = first->fileName() == crontab;
+        const bool secondIsCrontab = second->fileName() == crontab;
+        if (firstIsCrontab != secondIsCrontab) {
+            return firstIsCrontab;
+        }
+
+        return first->fileName() < second->fileName();
+    });
+
+    return systemCrons;
+}
+
 CTCron *CTHost::findUserCron(const QString &userLogin) const
 {
     for (CTCron *ctCron : std::as_const(mCrons)) {
@@ -221,8 +430,9 @@ CTCron *CTHost::findUserCron(const QString &userLogin) const
 
 CTCron *CTHost::findCronContaining(CTTask *ctTask) const
 {
+    // A task can't belong to a crontab which has not been read yet.
     for (CTCron *ctCron : std::as_const(mCrons)) {
-        if (ctCron->tasks().contains(ctTask)) {
+        if (ctCron->isLoaded() && ctCron->tasks().contains(ctTask)) {
             return ctCron;
         }
     }
@@ -231,10 +441,24 @@ CTCron *CTHost::findCronContaining(CTTask *ctTask) const
     return nullptr;
 }
 
+CTTimeline *CTHost::timeline()
+{
+    if (mTimeline == nullptr) {
+        mTimeline = new CTTimeline(mCrons);
+    }
+
+    return mTimeline;
+}
+
+CTCronWatcher *CTHost::watcher() const
+{
+    return mWatcher;
+}
+
 CTCron *CTHost::findCronContaining(CTVariable *ctVariable) const
 {
     for (CTCron *ctCron : std::as_const(mCrons)) {
-        if (ctCron->variables().contains(ctVariable)) {
+        if (ctCron->isLoaded() && ctCron->variables().contains(ctVariable)) {
             return ctCron;
         }
     }
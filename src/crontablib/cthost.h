@@ -11,13 +11,18 @@
 #include <QList>
 #include <QString>
 
+#include "ctAccessControl.h"
 #include "ctSaveStatus.h"
 
 class CTTask;
 class CTVariable;
 class CTCron;
 class CTInitializationError;
-class CrontabWidget;
+class CTTimeline;
+class CTSaveJob;
+class CTCronWatcher;
+
+class QObject;
 
 struct passwd;
 
@@ -37,8 +42,23 @@ public:
     /**
      * Constructs the user(s), scheduled tasks, and environment variables
      * from crontab files.
+     *
+     * If @p spoolDirectory is set and can be searched, user crontabs are
+     * read from it directly, and the crontab binary is only run for the
+     * ones which can't be read this way.
+     *
+     * With @p lazyLoading, only the current user and system crontabs are
+     * read here.  The crontabs of other users are read when asked to, see
+     * CTCron::deferLoading().
+     *
+     * The system crontab and its fragments are read from the crontab file
+     * and the cron.d directory of @p systemDirectory.
      */
-    CTHost(const QString &cronBinary, CTInitializationError &ctInitializationError);
+    CTHost(const QString &cronBinary,
+           CTInitializationError &ctInitializationError,
+           const QString &spoolDirectory = QString(),
+           bool lazyLoading = false,
+           const QString &systemDirectory = QStringLiteral("/etc"));
 
     /**
      * Destroys the user(s), scheduled tasks, and environment variable
@@ -48,10 +68,23 @@ public:
     ~CTHost();
 
     /**
-     * Apply changes.
+     * Apply changes of @p ctCron, one of the crons of this host.
      * return an empty string if no problem ocurred.
      */
-    CTSaveStatus save(CrontabWidget *mCrontabWidget);
+    CTSaveStatus save(CTCron *ctCron);
+
+    /**
+     * Apply changes of every cron which has been read, one after the other
+     * with CTCron::save().
+     */
+    CTSaveStatus save();
+
+    /**
+     * Job applying changes of every cron which has been read, without
+     * blocking the event loop.  Crons whose content did not change are not
+     * rewritten, see CTSaveJob.  The job is not started.
+     */
+    CTSaveJob *createSaveJob(QObject *parent = nullptr);
 
     /**
      * Cancel changes.
@@ -59,22 +92,75 @@ public:
     void cancel();
 
     /**
-     * Indicates whether or not dirty.
+     * Indicates whether or not dirty, that is whether any cron is dirty.
      */
     bool isDirty();
 
+    /**
+     * Called by crons of this host when they become dirty or clean.
+     */
+    void cronDirtyChanged(CTCron *ctCron, bool dirty);
+
+    /**
+     * Called by crons of this host once they have been read.
+     */
+    void cronLoaded(CTCron *ctCron);
+
     /**
      * Indicates whether or not the user is the root user.
      */
     bool isRootUser() const;
 
     CTCron *findCurrentUserCron() const;
+
+    /**
+     * The cron of /etc/crontab.
+     */
     CTCron *findSystemCron() const;
+
+    /**
+     * The system cron of @p fileName, /etc/crontab or a fragment of
+     * /etc/cron.d.
+     */
+    CTCron *findSystemCron(const QString &fileName) const;
+
+    /**
+     * The cron of /etc/crontab, then the ones of the fragments of
+     * /etc/cron.d, in file name order.
+     */
+    QList<CTCron *> systemCrons() const;
+
+    /**
+     * Adds the crons of the fragments created in /etc/cron.d, and removes
+     * the ones of the removed fragments, unless they have unsaved changes.
+     * Called when the watcher tells that /etc/cron.d changed.
+     */
+    void refreshSystemCrons();
+
     CTCron *findUserCron(const QString &userLogin) const;
 
     CTCron *findCronContaining(CTTask *ctTask) const;
     CTCron *findCronContaining(CTVariable *ctVariable) const;
 
+    /**
+     * Users allowed to use cron, according to /etc/cron.allow and /etc/cron.deny.
+     * Call CTAccessControl::refresh() to take changes of these files into account.
+     */
+    CTAccessControl *accessControl();
+
+    /**
+     * Index of the upcoming runs of every task of every cron.
+     * Created on first use, then kept up to date by the crons.
+     */
+    CTTimeline *timeline();
+
+    /**
+     * Reloads the crons whose crontab file changed on disk.
+     * Only crontabs read directly from a file can be watched, so user
+     * crontabs are only watched if the spool directory can be searched.
+     */
+    CTCronWatcher *watcher() const;
+
     /**
      * User(s).
      *
@@ -99,15 +185,46 @@ private:
 
     /**
      * Factory create a cron table.  Appends to the end of cron.
+     * The system crontab and each of its /etc/cron.d fragments are a cron
+     * of their own.
+     */
+    void createSystemCrons();
+
+    /**
+     * The system crontab file, in mSystemDirectory.
      */
-    CTCron *createSystemCron();
+    QString systemCrontab() const;
     QString createCTCron(const struct passwd *password);
 
+    /**
+     * Reads the crontabs of the user crons created so far, except lazy ones,
+     * running the crontab binary for several users at once.
+     */
+    void loadCrons();
+
     /**
      * Check /etc/cron.allow, /etc/cron.deny
      */
-    bool allowDeny(char *name);
+    CTAccessControl mAccessControl;
 
     QString mCrontabBinary;
+
+    QString mSpoolDirectory;
+
+    /**
+     * Directory of the system crontab and of its cron.d fragments.
+     */
+    QString mSystemDirectory;
+
+    bool mLazyLoading = false;
+
+    CTTimeline *mTimeline = nullptr;
+
+    CTCronWatcher *mWatcher = nullptr;
+
+    /**
+     * Count of dirty crons, kept up to date by the crons.
+     */
+    int mDirtyCronCount = 0;
 };
 
@@ -10,104 +10,122 @@
 
 #include <KLocalizedString>
 
-#include <QMimeDatabase>
-#include <QRegularExpression>
-#include <QUrl>
+#include <QtAlgorithms>
 
+#include "ctCommandIconCache.h"
+#include "ctCronWriter.h"
 #include "ctHelper.h"
+#include "ctTokenizer.h"
+
+/**
+ * If no matching day is found within this many years, the schedule can
+ * never match (e.g. "30 2 *" or an empty unit).  Eight years is enough to
+ * reach the next February 29th, even across a non leap century year.
+ */
+static const int MAXIMUM_SEARCH_YEARS = 8;
+
+/**
+ * Beyond this many runs a day, times are described as ranges rather than
+ * listed one by one.
+ */
+static const int MAXIMUM_LISTED_TIMES = 8;
+
+/**
+ * Time of the day such as "08:05".
+ */
+static QString formatTime(int hour, int minute)
+{
+    const QString hourString = QStringLiteral("%1").arg(hour, 2, 10, QLatin1Char('0'));
+    const QString minuteString = QStringLiteral("%1").arg(minute, 2, 10, QLatin1Char('0'));
+
+    return i18nc("1:Hour, 2:Minute", "%1:%2", hourString, minuteString);
+}
+
+/**
+ * Smallest enabled value of @p mask greater than or equal to @p from,
+ * or -1 if there is none.
+ */
+static int nextEnabled(quint64 mask, int from)
+{
+    if (from > 63) {
+        return -1;
+    }
+
+    const quint64 remaining = mask & ~((quint64(1) << from) - 1);
+    if (remaining == 0) {
+        return -1;
+    }
+
+    return qCountTrailingZeroBits(remaining);
+}
 
 CTTask::CTTask(const QString &tokenString, const QString &_comment, const QString &_userLogin, bool _systemCrontab)
     : mSystemCrontab(_systemCrontab)
 {
-    QString tokStr = tokenString;
-    if (tokStr.mid(0, 2) == QLatin1String("#\\")) {
-        tokStr = tokStr.mid(2, tokStr.length() - 2);
+    QStringView tokStr(tokenString);
+    if (tokStr.startsWith(QLatin1String("#\\"))) {
+        tokStr = tokStr.sliced(2);
         enabled = false;
-    } else if (tokStr.mid(0, 1) == QLatin1String("#")) {
-        tokStr = tokStr.mid(1, tokStr.length() - 1);
+    } else if (tokStr.startsWith(QLatin1Char('#'))) {
+        tokStr = tokStr.sliced(1);
         enabled = false;
     } else {
         enabled = true;
     }
 
     // Skip over 'silence' if found... old option in vixie cron
-    if (tokStr.mid(0, 1) == QLatin1String("-")) {
-        tokStr = tokStr.mid(1, tokStr.length() - 1);
+    if (tokStr.startsWith(QLatin1Char('-'))) {
+        tokStr = tokStr.sliced(1);
     }
 
+    // Nicknames are rare, so simply expand them to the five scheduling fields.
+    QString expandedTokStr;
     reboot = false;
-    if (tokStr.mid(0, 1) == QLatin1String("@")) {
-        if (tokStr.mid(1, 6) == QLatin1String("yearly")) {
-            tokStr = QLatin1String("0 0 1 1 *") + tokStr.mid(7, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 8) == QLatin1String("annually")) {
-            tokStr = QLatin1String("0 0 1 1 *") + tokStr.mid(9, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 7) == QLatin1String("monthly")) {
-            tokStr = QLatin1String("0 0 1 * *") + tokStr.mid(8, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 6) == QLatin1String("weekly")) {
-            tokStr = QLatin1String("0 0 * * 0") + tokStr.mid(7, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 5) == QLatin1String("daily")) {
-            tokStr = QLatin1String("0 0 * * *") + tokStr.mid(6, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 6) == QLatin1String("hourly")) {
-            tokStr = QLatin1String("0 * * * *") + tokStr.mid(7, tokStr.length() - 1);
-        } else if (tokStr.mid(1, 6) == QLatin1String("reboot")) {
-            tokStr = tokStr.mid(7, tokStr.length() - 1);
+    if (tokStr.startsWith(QLatin1Char('@'))) {
+        if (tokStr.sliced(1).startsWith(QLatin1String("yearly"))) {
+            expandedTokStr = QLatin1String("0 0 1 1 *") + tokStr.sliced(7);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("annually"))) {
+            expandedTokStr = QLatin1String("0 0 1 1 *") + tokStr.sliced(9);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("monthly"))) {
+            expandedTokStr = QLatin1String("0 0 1 * *") + tokStr.sliced(8);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("weekly"))) {
+            expandedTokStr = QLatin1String("0 0 * * 0") + tokStr.sliced(7);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("daily"))) {
+            expandedTokStr = QLatin1String("0 0 * * *") + tokStr.sliced(6);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("hourly"))) {
+            expandedTokStr = QLatin1String("0 * * * *") + tokStr.sliced(7);
+        } else if (tokStr.sliced(1).startsWith(QLatin1String("reboot"))) {
+            tokStr = tokStr.sliced(7);
             reboot = true;
         }
-    }
-
-    int spacePos(tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]"))));
-    // If reboot bypass initialize functions so no keys selected in modify task
-    if (!reboot) {
-        minute.initialize(tokStr.mid(0, spacePos));
 
-        while (isSpaceAt(tokStr, spacePos + 1)) {
-            spacePos++;
+        if (!expandedTokStr.isEmpty()) {
+            tokStr = expandedTokStr;
         }
-        tokStr = tokStr.mid(spacePos + 1, tokStr.length() - 1);
-        spacePos = tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]")));
-        hour.initialize(tokStr.mid(0, spacePos));
+    }
 
-        while (isSpaceAt(tokStr, spacePos + 1)) {
-            spacePos++;
-        }
-        tokStr = tokStr.mid(spacePos + 1, tokStr.length() - 1);
-        spacePos = tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]")));
-        dayOfMonth.initialize(tokStr.mid(0, spacePos));
+    CTTokenizer tokenizer(tokStr);
 
-        while (isSpaceAt(tokStr, spacePos + 1)) {
-            spacePos++;
-        }
-        tokStr = tokStr.mid(spacePos + 1, tokStr.length() - 1);
-        spacePos = tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]")));
-        month.initialize(tokStr.mid(0, spacePos));
-
-        while (isSpaceAt(tokStr, spacePos + 1)) {
-            spacePos++;
-        }
-        tokStr = tokStr.mid(spacePos + 1, tokStr.length() - 1);
-        spacePos = tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]")));
-        dayOfWeek.initialize(tokStr.mid(0, spacePos));
+    // If reboot bypass initialize functions so no keys selected in modify task
+    if (!reboot) {
+        minute.initialize(tokenizer.nextField().toString());
+        hour.initialize(tokenizer.nextField().toString());
+        dayOfMonth.initialize(tokenizer.nextField().toString());
+        month.initialize(tokenizer.nextField().toString());
+        dayOfWeek.initialize(tokenizer.nextField().toString());
     }
 
     // Since it's a multiuser(system) task, the token contains the user login,
     // and the command, separated by a tab (\t).
-    // The two need to subsequently be separated again.
     // E.g. "root\tmy_test_script.sh"
     if (mSystemCrontab) {
-        while (isSpaceAt(tokStr, spacePos + 1)) {
-            spacePos++;
-        }
-        tokStr = tokStr.mid(spacePos + 1, tokStr.length() - 1);
-        spacePos = tokStr.indexOf(QRegularExpression(QLatin1String("[ \t]")));
-        userLogin = tokStr.mid(0, spacePos);
+        userLogin = tokenizer.nextField().toString();
     } else {
         userLogin = _userLogin;
     }
-    command = tokStr.mid(spacePos + 1, tokStr.length() - 1);
+
     // remove leading whitespace
-    while (command.indexOf(QRegularExpression(QLatin1String("[ \t]"))) == 0) {
-        command = command.mid(1, command.length() - 1);
-    }
+    command = tokenizer.remaining().toString();
     comment = _comment;
 
     mInitialUserLogin = userLogin;
@@ -165,22 +183,36 @@ QString CTTask::exportTask()
 {
     QString exportTask;
 
-    exportTask += CTHelper::exportComment(comment);
+    CTCronWriter writer(&exportTask);
+    writeTask(writer);
+
+    return exportTask;
+}
+
+void CTTask::writeTask(CTCronWriter &writer) const
+{
+    CTHelper::writeComment(writer, comment);
 
     if (!enabled) {
-        exportTask += QLatin1String("#\\");
+        writer << QLatin1String("#\\");
     }
 
-    exportTask += schedulingCronFormat();
-    exportTask += QLatin1String("\t");
+    if (reboot) {
+        writer << QLatin1String("@reboot");
+    } else {
+        writer << minute.exportUnit() << QLatin1Char(' ');
+        writer << hour.exportUnit() << QLatin1Char(' ');
+        writer << dayOfMonth.exportUnit() << QLatin1Char(' ');
+        writer << month.exportUnit() << QLatin1Char(' ');
+        writer << dayOfWeek.exportUnit();
+    }
+    writer << QLatin1Char('\t');
 
     if (isSystemCrontab()) {
-        exportTask += userLogin + QLatin1String("\t");
+        writer << userLogin << QLatin1Char('\t');
     }
 
-    exportTask += command + QLatin1String("\n");
-
-    return exportTask;
+    writer << command << QLatin1Char('\n');
 }
 
 void CTTask::apply()
@@ -234,6 +266,37 @@ QString CTTask::schedulingCronFormat() const
     return scheduling;
 }
 
+bool CTTaskDescriptionKey::operator==(const CTTaskDescriptionKey &other) const
+{
+    return minutes == other.minutes && hours == other.hours && daysOfMonth == other.daysOfMonth && months == other.months && daysOfWeek == other.daysOfWeek
+        && reboot == other.reboot && languages == other.languages;
+}
+
+CTTaskDescriptionKey CTTask::descriptionKey() const
+{
+    CTTaskDescriptionKey key;
+    key.minutes = minute.enabledMask();
+    key.hours = hour.enabledMask();
+    key.daysOfMonth = dayOfMonth.enabledMask();
+    key.months = month.enabledMask();
+    key.daysOfWeek = dayOfWeek.enabledMask();
+    key.reboot = reboot;
+    key.languages = KLocalizedString::languages();
+    return key;
+}
+
+QString CTTask::describe() const
+{
+    // Creating a description is costly, and list views ask for it on every refresh.
+    const CTTaskDescriptionKey key = descriptionKey();
+    if (mDescription.isEmpty() || !(key == mDescriptionKey)) {
+        mDescription = createDescription();
+        mDescriptionKey = key;
+    }
+
+    return mDescription;
+}
+
 /**
  * Of the whole program, this method is probably the trickiest.
  *
@@ -259,7 +322,7 @@ QString CTTask::schedulingCronFormat() const
  * description.
  *
  */
-QString CTTask::describe() const
+QString CTTask::createDescription() const
 {
     if (reboot) {
         return i18n("At system startup");
@@ -319,23 +382,7 @@ QString CTTask::describeDateAndHours() const
         if (hour.isEnabled(h)) {
             for (int m = 0; m <= 59; m++) {
                 if (minute.isEnabled(m)) {
-                    QString hourString;
-                    if (h < 10) {
-                        hourString = QLatin1String("0") + QString::number(h);
-                    } else {
-                        hourString = QString::number(h);
-                    }
-
-                    QString minuteString;
-                    if (m < 10) {
-                        minuteString = QLatin1String("0") + QString::number(m);
-                    } else {
-                        minuteString = QString::number(m);
-                    }
-
-                    QString tmpStr = i18nc("1:Hour, 2:Minute", "%1:%2", hourString, minuteString);
-
-                    timeDesc += tmpStr;
+                    timeDesc += formatTime(h, m);
                     count++;
                     switch (total - count) {
                     case 0:
@@ -360,14 +407,182 @@ QString CTTask::describeDateAndHours() const
 
 QString CTTask::createTimeFormat() const
 {
+    const int minutePeriod = minute.findPeriod();
     if (hour.isAllEnabled()) {
-        int minutePeriod = minute.findPeriod();
         if (minutePeriod != 0) {
             return i18np("Every minute", "Every %1 minutes", minutePeriod);
         }
     }
 
-    return describeDateAndHours();
+    // A few times read better one by one.
+    const int minuteCount = minute.enabledCount();
+    if (minuteCount * hour.enabledCount() <= MAXIMUM_LISTED_TIMES) {
+        return describeDateAndHours();
+    }
+
+    // Periodic minutes during consecutive hours run at a single interval.
+    const quint64 hours = hour.enabledMask();
+    const int firstHour = qCountTrailingZeroBits(hours);
+    const quint64 hourRun = hours >> firstHour;
+    if (minutePeriod != 0 && (hourRun & (hourRun + 1)) == 0) {
+        const int lastHour = firstHour + qPopulationCount(hours) - 1;
+        return i18np("Every minute between %2 and %3",
+                     "Every %1 minutes between %2 and %3",
+                     minutePeriod,
+                     formatTime(firstHour, 0),
+                     formatTime(lastHour, minute.maximum() + 1 - minutePeriod));
+    }
+
+    return i18ncp("1:Minute count, 2:Minute list, 3:Hour list",
+                  "At minute %2 of hours %3",
+                  "At minutes %2 of hours %3",
+                  minuteCount,
+                  minute.describeRanges(),
+                  hour.describeRanges());
+}
+
+quint64 CTTask::runningDays(int year, int monthNumber) const
+{
+    const QDate firstDay(year, monthNumber, 1);
+    const int daysInMonth = firstDay.daysInMonth();
+    const quint64 monthDays = ((quint64(1) << (daysInMonth + 1)) - 1) & ~quint64(1);
+
+    const quint64 daysOfMonth = dayOfMonth.enabledMask() & monthDays;
+
+    // QDate and CTDayOfWeek both number days of week from 1 (Monday) to 7 (Sunday).
+    quint64 daysOfWeek = 0;
+    const int firstDayOfWeek = firstDay.dayOfWeek();
+    const quint64 weekDays = dayOfWeek.enabledMask();
+    for (int dow = CTDayOfWeek::MINIMUM; dow <= CTDayOfWeek::MAXIMUM; dow++) {
+        if (weekDays & (quint64(1) << dow)) {
+            for (int day = (dow - firstDayOfWeek + 7) % 7 + 1; day <= daysInMonth; day += 7) {
+                daysOfWeek |= quint64(1) << day;
+            }
+        }
+    }
+
+    // Vixie cron only requires both fields to match when one of them starts with "*".
+    if (dayOfMonth.isStarred() || dayOfWeek.isStarred()) {
+        return daysOfMonth & daysOfWeek;
+    }
+
+    return daysOfMonth | daysOfWeek;
+}
+
+QList<QDateTime> CTTask::nextOccurrences(const QDateTime &from, int count) const
+{
+    QList<QDateTime> occurrences;
+
+    if (reboot || !enabled || count <= 0) {
+        return occurrences;
+    }
+
+    const quint64 minutes = minute.enabledMask();
+    const quint64 hours = hour.enabledMask();
+    const quint64 months = month.enabledMask();
+    if (minutes == 0 || hours == 0 || months == 0) {
+        return occurrences;
+    }
+
+    // Cron runs at the start of a minute, so begin with the next one.
+    QDateTime start = from.addSecs(60);
+    start.setTime(QTime(start.time().hour(), start.time().minute()));
+
+    int y = start.date().year();
+    int mo = start.date().month();
+    int d = start.date().day();
+    int h = start.time().hour();
+    int mi = start.time().minute();
+
+    const int lastYear = y + MAXIMUM_SEARCH_YEARS;
+
+    int daysYear = 0;
+    int daysMonth = 0;
+    quint64 days = 0;
+
+    // Each step jumps to the next enabled value of a unit, or carries into the
+    // upper unit and resets the lower ones, so disabled values are never visited.
+    while (occurrences.count() < count && y <= lastYear) {
+        const int nextMonth = nextEnabled(months, mo);
+        if (nextMonth == -1) {
+            y++;
+            mo = CTMonth::MINIMUM;
+            d = CTDayOfMonth::MINIMUM;
+            h = 0;
+            mi = 0;
+            continue;
+        }
+        if (nextMonth != mo) {
+            mo = nextMonth;
+            d = CTDayOfMonth::MINIMUM;
+            h = 0;
+            mi = 0;
+        }
+
+        if (daysYear != y || daysMonth != mo) {
+            daysYear = y;
+            daysMonth = mo;
+            days = runningDays(y, mo);
+        }
+
+        const int nextDay = nextEnabled(days, d);
+        if (nextDay == -1) {
+            mo++;
+            d = CTDayOfMonth::MINIMUM;
+            h = 0;
+            mi = 0;
+            continue;
+        }
+        if (nextDay != d) {
+            d = nextDay;
+            h = 0;
+            mi = 0;
+        }
+
+        const int nextHour = nextEnabled(hours, h);
+        if (nextHour == -1) {
+            d++;
+            h = 0;
+            mi = 0;
+            continue;
+        }
+        if (nextHour != h) {
+            h = nextHour;
+            mi = 0;
+        }
+
+        const int nextMinute = nextEnabled(minutes, mi);
+        if (nextMinute == -1) {
+            h++;
+            mi = 0;
+            continue;
+        }
+        mi = nextMinute;
+
+        QDateTime occurrence(start);
+        occurrence.setDate(QDate(y, mo, d));
+        occurrence.setTime(QTime(h, mi));
+
+        // Local times skipped by a daylight saving change are moved forward
+        // by QDateTime, and may then collide with an already found occurrence.
+        if (occurrences.isEmpty() || occurrence > occurrences.constLast()) {
+            occurrences.append(occurrence);
+        }
+
+        mi++;
+    }
+
+    return occurrences;
+}
+
+QDateTime CTTask::nextOccurrence(const QDateTime &from) const
+{
+    const QList<QDateTime> occurrences = nextOccurrences(from, 1);
+    if (occurrences.isEmpty()) {
+        return QDateTime();
+    }
+
+    return occurrences.constFirst();
 }
 
 bool CTTask::isSystemCrontab() const
@@ -380,17 +595,9 @@ void CTTask::setSystemCrontab(bool _systemCrontab)
     mSystemCrontab = _systemCrontab;
 }
 
-QIcon CTTask::commandIcon() const
+QIcon CTTask::commandIcon(CTCommandIconCache *commandIconCache) const
 {
-    QUrl commandPath = QUrl::fromLocalFile(completeCommandPath());
-
-    QMimeType mimeType = QMimeDatabase().mimeTypeForUrl(commandPath);
-    // qCDebug(KCM_CRON_LOG) << mimeType->name();
-    if (mimeType.name() == QLatin1String("application/x-executable") || mimeType.name() == QLatin1String("application/octet-stream")) {
-        return QIcon::fromTheme(commandPath.fileName(), QIcon::fromTheme(QLatin1String("system-run")));
-    }
-
-    return QIcon::fromTheme(mimeType.iconName());
+    return commandIconCache->icon(completeCommandPath());
 }
 
 QPair<QString, bool> CTTask::unQuoteCommand() const
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <QDateTime>
 #include <QIcon>
+#include <QList>
 #include <QPair>
 #include <QString>
 #include <QStringList>
@@ -19,6 +21,32 @@
 #include "ctminute.h"
 #include "ctmonth.h"
 
+class CTCommandIconCache;
+class CTCronWriter;
+
+/**
+ * What the natural language description of a task depends on: its
+ * schedule and the languages it is translated to.
+ */
+class CTTaskDescriptionKey
+{
+public:
+    bool operator==(const CTTaskDescriptionKey &other) const;
+
+    quint64 minutes = 0;
+    quint64 hours = 0;
+    quint64 daysOfMonth = 0;
+    quint64 months = 0;
+    quint64 daysOfWeek = 0;
+    bool reboot = false;
+
+    /**
+     * KLocalizedString::languages(), which change with the language of the
+     * application, unlike the default QLocale.
+     */
+    QStringList languages;
+};
+
 /**
  * A scheduled task (encapsulation of crontab entry).  Encapsulates
  * parsing, tokenization, and natural language description.
@@ -46,6 +74,11 @@ public:
      */
     QString exportTask();
 
+    /**
+     * Writes the crontab format of the task to @p writer.
+     */
+    void writeTask(CTCronWriter &writer) const;
+
     /**
      * Scheduling using the cron format.
      */
@@ -68,9 +101,28 @@ public:
 
     /**
      * Returns natural language description of the task's schedule.
+     * The description is kept until the schedule or the locale changes.
      */
     QString describe() const;
 
+    /**
+     * Returns the next @p count times at which cron will run this task,
+     * strictly after @p from and in the time zone of @p from.
+     *
+     * Follows Vixie cron semantics: when neither the day of month nor the
+     * day of week is unrestricted, a day matches if either of them does.
+     *
+     * Disabled tasks and "@reboot" tasks never run at a given time, so
+     * the list is empty for them.
+     */
+    QList<QDateTime> nextOccurrences(const QDateTime &from, int count) const;
+
+    /**
+     * Returns the next time at which cron will run this task, strictly
+     * after @p from, or an invalid QDateTime if there is none.
+     */
+    QDateTime nextOccurrence(const QDateTime &from) const;
+
     /**
      * Indicates whether or not the task belongs to the system crontab.
      */
@@ -78,7 +130,10 @@ public:
 
     void setSystemCrontab(bool systemCrontab);
 
-    QIcon commandIcon() const;
+    /**
+     * Icon of the command, or a placeholder until @p commandIconCache has found it.
+     */
+    QIcon commandIcon(CTCommandIconCache *commandIconCache) const;
 
     /**
      * Internal methods
@@ -103,18 +158,8 @@ public:
     bool reboot;
 
 private:
-    inline bool isSpaceAt(const QString &token, int pos)
-    {
-        if (pos >= token.length()) {
-            return false;
-        }
-
-        if (token.at(pos) == QLatin1Char(' ')) {
-            return true;
-        }
-
-        return false;
-    }
+    QString createDescription() const;
+    CTTaskDescriptionKey descriptionKey() const;
 
     QString describeDayOfMonth() const;
     QString describeDayOfWeek() const;
@@ -123,6 +168,11 @@ private:
     QString createTimeFormat() const;
     QString createDateFormat() const;
 
+    /**
+     * Days of the given month on which the task runs, bit N meaning day N.
+     */
+    quint64 runningDays(int year, int monthNumber) const;
+
     bool mSystemCrontab;
 
     QString mInitialUserLogin;
@@ -130,5 +180,11 @@ private:
     QString mInitialComment;
     bool mInitialEnabled;
     bool mInitialReboot;
+
+    /**
+     * Last description, and what it was created from.
+     */
+    mutable QString mDescription;
+    mutable CTTaskDescriptionKey mDescriptionKey;
 };
 
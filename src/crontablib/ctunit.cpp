@@ -10,6 +10,23 @@
 
 #include <KLocalizedString>
 
+#include <QStringList>
+#include <QtAlgorithms>
+
+/**
+ * Day and month names accepted by cron, indexed by their value.
+ */
+static const char *const dayNames[] = {"sun", "mon", "tue", "wed", "thu", "fri", "sat"};
+static const int dayNamesCount = sizeof(dayNames) / sizeof(dayNames[0]);
+
+static const char *const monthNames[] = {"", "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec"};
+static const int monthNamesCount = sizeof(monthNames) / sizeof(monthNames[0]);
+
+static inline quint64 valueBit(int value)
+{
+    return quint64(1) << value;
+}
+
 CTUnit::CTUnit(int _min, int _max, const QString &tokStr)
 {
     mMin = _min;
@@ -22,15 +39,11 @@ CTUnit::CTUnit(const CTUnit &source)
     mMin = source.mMin;
     mMax = source.mMax;
 
-    mInitialEnabled.clear();
-    mEnabled.clear();
-    mInitialEnabled.reserve(mMax + 1);
-    for (int i = 0; i <= mMax; i++) {
-        mInitialEnabled.append(false);
-        mEnabled.append(source.mEnabled.at(i));
-    }
+    mInitialEnabled = 0;
+    mEnabled = source.mEnabled;
 
     mInitialTokStr = QLatin1String("");
+    mInitialStarred = false;
     mDirty = true;
 }
 
@@ -47,10 +60,7 @@ CTUnit &CTUnit::operator=(const CTUnit &unit)
     mMin = unit.mMin;
     mMax = unit.mMax;
 
-    mEnabled.clear();
-    for (int i = 0; i <= mMax; i++) {
-        mEnabled.append(unit.mEnabled[i]);
-    }
+    mEnabled = unit.mEnabled;
     mDirty = true;
 
     return *this;
@@ -58,34 +68,34 @@ CTUnit &CTUnit::operator=(const CTUnit &unit)
 
 void CTUnit::initialize(const QString &tokStr)
 {
-    mEnabled.clear();
-    for (int i = 0; i <= mMax; i++) {
-        mEnabled.append(false);
-        mInitialEnabled.append(false);
-    }
-
-    for (int i = mMin; i <= mMax; i++) {
-        mInitialEnabled[i] = mEnabled[i];
-    }
+    mEnabled = 0;
+    mInitialEnabled = 0;
 
     parse(tokStr);
     mInitialTokStr = tokStr;
+    mInitialStarred = tokStr.startsWith(QLatin1Char('*'));
     mDirty = false;
 }
 
-void CTUnit::parse(const QString &tokenString)
+void CTUnit::parse(QStringView tokenString)
 {
-    QString tokStr = tokenString;
-
     // subelement is that which is between commas
-    QString subelement;
-    int commapos, slashpos, dashpos;
+    int slashpos, dashpos;
     int beginat, endat, step;
 
-    // loop through each subelement
-    tokStr += QLatin1Char(',');
-    while ((commapos = tokStr.indexOf(QLatin1Char(','))) > 0) {
-        subelement = tokStr.mid(0, commapos);
+    // loop through each subelement, stopping at the first empty one
+    qsizetype begin = 0;
+    while (begin < tokenString.size()) {
+        qsizetype commapos = tokenString.indexOf(QLatin1Char(','), begin);
+        if (commapos == -1) {
+            commapos = tokenString.size();
+        }
+
+        const QStringView subelement = tokenString.sliced(begin, commapos - begin);
+        if (subelement.isEmpty()) {
+            break;
+        }
+        begin = commapos + 1;
 
         // find "/" to determine step
         slashpos = subelement.indexOf(QLatin1Char('/'));
@@ -93,7 +103,7 @@ void CTUnit::parse(const QString &tokenString)
             step = 1;
             slashpos = subelement.length();
         } else {
-            step = fieldToValue(subelement.mid(slashpos + 1, subelement.length() - slashpos - 1));
+            step = fieldToValue(subelement.sliced(slashpos + 1));
             if (step < 1) {
                 step = 1;
             }
@@ -103,16 +113,20 @@ void CTUnit::parse(const QString &tokenString)
         dashpos = subelement.indexOf(QLatin1Char('-'));
         if (dashpos == -1) {
             // deal with "*"
-            if (subelement.mid(0, slashpos) == QLatin1Char('*')) {
+            if (subelement.first(slashpos) == QLatin1Char('*')) {
                 beginat = mMin;
                 endat = mMax;
             } else {
-                beginat = fieldToValue(subelement.mid(0, slashpos));
+                beginat = fieldToValue(subelement.first(slashpos));
                 endat = beginat;
             }
         } else {
-            beginat = fieldToValue(subelement.mid(0, dashpos));
-            endat = fieldToValue(subelement.mid(dashpos + 1, slashpos - dashpos - 1));
+            beginat = fieldToValue(subelement.first(dashpos));
+            if (dashpos < slashpos) {
+                endat = fieldToValue(subelement.sliced(dashpos + 1, slashpos - dashpos - 1));
+            } else {
+                endat = fieldToValue(subelement.sliced(dashpos + 1));
+            }
         }
 
         // ignore out of range
@@ -125,11 +139,11 @@ void CTUnit::parse(const QString &tokenString)
 
         // setup enabled
         for (int i = beginat; i <= endat; i += step) {
-            mInitialEnabled[i] = mEnabled[i] = true;
+            mEnabled |= valueBit(i);
         }
-
-        tokStr = tokStr.mid(commapos + 1, tokStr.length() - commapos - 1);
     }
+
+    mInitialEnabled = mEnabled;
 }
 
 QString CTUnit::exportUnit() const
@@ -142,18 +156,16 @@ QString CTUnit::exportUnit() const
         return QStringLiteral("*");
     }
 
-    int total = enabledCount();
-    int count = 0;
     QString tokenizeUnit;
 
-    for (int num = mMin; num <= mMax; num++) {
-        if (mEnabled[num]) {
-            tokenizeUnit += QString::number(num);
-            count++;
+    quint64 remaining = enabledMask();
+    while (remaining != 0) {
+        const int num = qCountTrailingZeroBits(remaining);
+        remaining &= remaining - 1;
 
-            if (count < total) {
-                tokenizeUnit += QLatin1Char(',');
-            }
+        tokenizeUnit += QString::number(num);
+        if (remaining != 0) {
+            tokenizeUnit += QLatin1Char(',');
         }
     }
 
@@ -165,28 +177,89 @@ QString CTUnit::genericDescribe(const QList<QString> &label) const
     int total(enabledCount());
     int count(0);
     QString tmpStr;
-    for (int i = mMin; i <= mMax; i++) {
-        if (mEnabled[i]) {
-            tmpStr += label.at(i);
-            count++;
-            switch (total - count) {
-            case 0:
-                break;
-            case 1:
-                if (total > 2) {
-                    tmpStr += i18n(",");
-                }
-                tmpStr += i18n(" and ");
-                break;
-            default:
-                tmpStr += i18n(", ");
-                break;
+    quint64 remaining = enabledMask();
+    while (remaining != 0) {
+        const int i = qCountTrailingZeroBits(remaining);
+        remaining &= remaining - 1;
+
+        tmpStr += label.at(i);
+        count++;
+        switch (total - count) {
+        case 0:
+            break;
+        case 1:
+            if (total > 2) {
+                tmpStr += i18n(",");
             }
+            tmpStr += i18n(" and ");
+            break;
+        default:
+            tmpStr += i18n(", ");
+            break;
         }
     }
     return tmpStr;
 }
 
+QString CTUnit::describeRanges() const
+{
+    QStringList ranges;
+
+    quint64 remaining = enabledMask();
+    while (remaining != 0) {
+        const int first = qCountTrailingZeroBits(remaining);
+        remaining &= remaining - 1;
+
+        if (remaining == 0) {
+            ranges.append(QString::number(first));
+            break;
+        }
+
+        // Follow the step to the second value as far as possible.
+        const int step = qCountTrailingZeroBits(remaining) - first;
+        quint64 range = valueBit(first);
+        int last = first;
+        while (last + step <= mMax && (remaining & valueBit(last + step))) {
+            last += step;
+            range |= valueBit(last);
+        }
+
+        // Two values read better on their own.
+        if (last - first < 2 * step) {
+            ranges.append(QString::number(first));
+            continue;
+        }
+
+        remaining &= ~range;
+        if (step == 1) {
+            ranges.append(i18nc("1:First value, 2:Last value", "%1-%2", first, last));
+        } else {
+            ranges.append(i18nc("1:First value, 2:Last value, 3:Step", "%1-%2 every %3", first, last, step));
+        }
+    }
+
+    QString description;
+    const int total = ranges.count();
+    for (int count = 1; count <= total; count++) {
+        description += ranges.at(count - 1);
+        switch (total - count) {
+        case 0:
+            break;
+        case 1:
+            if (total > 2) {
+                description += i18n(",");
+            }
+            description += i18n(" and ");
+            break;
+        default:
+            description += i18n(", ");
+            break;
+        }
+    }
+
+    return description;
+}
+
 int CTUnit::minimum() const
 {
     return mMin;
@@ -199,27 +272,49 @@ int CTUnit::maximum() const
 
 bool CTUnit::isEnabled(int pos) const
 {
-    return mEnabled.at(pos);
+    Q_ASSERT(pos >= 0 && pos <= mMax);
+    return (mEnabled & valueBit(pos)) != 0;
 }
 
 bool CTUnit::isAllEnabled() const
 {
-    for (int i = mMin; i <= mMax; i++) {
-        if (!mEnabled.at(i)) {
-            return false;
-        }
+    const quint64 range = rangeMask();
+    return (mEnabled & range) == range;
+}
+
+bool CTUnit::isStarred() const
+{
+    // Modified units are exported as "*" only when every value is enabled.
+    if (mDirty) {
+        return isAllEnabled();
     }
 
-    return true;
+    return mInitialStarred;
 }
 
 void CTUnit::setEnabled(int pos, bool value)
 {
-    mEnabled[pos] = value;
+    Q_ASSERT(pos >= 0 && pos <= mMax);
+    if (value) {
+        mEnabled |= valueBit(pos);
+    } else {
+        mEnabled &= ~valueBit(pos);
+    }
     mDirty = true;
     return;
 }
 
+quint64 CTUnit::enabledMask() const
+{
+    return mEnabled & rangeMask();
+}
+
+quint64 CTUnit::rangeMask() const
+{
+    // mMax is at most 59, so the shift never overflows.
+    return (valueBit(mMax + 1) - 1) & ~(valueBit(mMin) - 1);
+}
+
 bool CTUnit::isDirty() const
 {
     return mDirty;
@@ -227,53 +322,37 @@ bool CTUnit::isDirty() const
 
 int CTUnit::enabledCount() const
 {
-    int total(0);
-    for (int i = mMin; i <= mMax; i++) {
-        total += (mEnabled[i] == true);
-    }
-    return total;
+    return qPopulationCount(enabledMask());
 }
 
 void CTUnit::apply()
 {
     mInitialTokStr = exportUnit();
-    for (int i = mMin; i <= mMax; i++) {
-        mInitialEnabled[i] = mEnabled.at(i);
-    }
+    mInitialStarred = mInitialTokStr.startsWith(QLatin1Char('*'));
+    mInitialEnabled = mEnabled;
     mDirty = false;
 }
 
 void CTUnit::cancel()
 {
-    for (int i = mMin; i <= mMax; i++) {
-        mEnabled[i] = mInitialEnabled.at(i);
-    }
+    mEnabled = mInitialEnabled;
     mDirty = false;
 }
 
-int CTUnit::fieldToValue(const QString &entry) const
+int CTUnit::fieldToValue(QStringView entry) const
 {
-    QString lower = entry.toLower();
-
     // check for days
-    QList<QString> days;
-    days << QStringLiteral("sun") << QStringLiteral("mon") << QStringLiteral("tue") << QStringLiteral("wed") << QStringLiteral("thu") << QStringLiteral("fri")
-         << QStringLiteral("sat");
-
-    int day = days.indexOf(lower);
-    if (day != -1) {
-        return day;
+    for (int day = 0; day < dayNamesCount; ++day) {
+        if (entry.compare(QLatin1String(dayNames[day]), Qt::CaseInsensitive) == 0) {
+            return day;
+        }
     }
 
     // check for months
-    QList<QString> months;
-    months << QLatin1String("") << QStringLiteral("jan") << QStringLiteral("feb") << QStringLiteral("mar") << QStringLiteral("apr") << QStringLiteral("may")
-           << QStringLiteral("jun") << QStringLiteral("jul") << QStringLiteral("aug") << QStringLiteral("sep") << QStringLiteral("oct") << QStringLiteral("nov")
-           << QStringLiteral("dec");
-
-    int month = months.indexOf(lower);
-    if (month != -1) {
-        return month;
+    for (int month = 1; month < monthNamesCount; ++month) {
+        if (entry.compare(QLatin1String(monthNames[month]), Qt::CaseInsensitive) == 0) {
+            return month;
+        }
     }
 
     // If the string does not match a day ora month, then it's a simple number (minute, hour or day of month)
@@ -286,24 +365,15 @@ int CTUnit::fieldToValue(const QString &entry) const
  */
 int CTUnit::findPeriod(const QList<int> &periods) const
 {
-    for (int period : periods) {
-        bool validPeriod = true;
-
-        for (int i = minimum(); i <= maximum(); i++) {
-            bool periodTesting;
-            if ((double)i / (double)period == i / period) {
-                periodTesting = true;
-            } else {
-                periodTesting = false;
-            }
+    const quint64 enabled = enabledMask();
 
-            if (isEnabled(i) != periodTesting) {
-                validPeriod = false;
-                break;
-            }
+    for (int period : periods) {
+        quint64 periodMask = 0;
+        for (int i = minimum() + (period - minimum() % period) % period; i <= maximum(); i += period) {
+            periodMask |= valueBit(i);
         }
 
-        if (validPeriod) {
+        if (enabled == periodMask) {
             return period;
         }
     }
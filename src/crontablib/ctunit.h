@@ -10,11 +10,16 @@
 
 #include <QList>
 #include <QString>
+#include <QStringView>
+#include <QtGlobal>
 
 /**
  * A cron table unit parser and tokenizer.
  * Parses/tokenizes unit such as "0-3,5,6,10-30/5"
  * Also provides default natural language description.
+ *
+ * Enabled intervals are stored as a 64 bits mask, bit N meaning
+ * value N is enabled.  The widest unit (minutes) uses 60 bits.
  */
 class CTUnit
 {
@@ -71,8 +76,20 @@ public:
 
     bool isAllEnabled() const;
 
+    /**
+     * Indicates whether the unit is written starting with "*", with or
+     * without a step.  Cron matches a day when either the day of month or
+     * the day of week matches, unless one of them is written this way.
+     */
+    bool isStarred() const;
+
     void setEnabled(int pos, bool value);
 
+    /**
+     * Bit mask of enabled intervals, restricted to [minimum(), maximum()].
+     */
+    quint64 enabledMask() const;
+
     /**
      * Indicates whether enabled intervals have been modified.
      */
@@ -94,6 +111,13 @@ public:
      */
     void cancel();
 
+    /**
+     * Describes enabled values with runs and steps compressed into ranges,
+     * such as "0-30 every 10 and 45", at a cost proportional to the
+     * number of ranges.
+     */
+    QString describeRanges() const;
+
     /**
      * Find a period in enabled values
      * If no period has been found, return 0
@@ -104,21 +128,32 @@ protected:
     /**
      * Parses unit such as "0-3,5,6,10-30/5".
      * Does not initialize array of enabled intervals.
+     * Works on views of the token, and does not allocate memory.
+     */
+    void parse(QStringView tokenString);
+
+    /**
+     * Bit mask with every value of [minimum(), maximum()] enabled.
      */
-    void parse(const QString &tokenString = QLatin1String(""));
+    quint64 rangeMask() const;
 
 private:
     int mMin;
     int mMax;
 
-    int fieldToValue(const QString &entry) const;
+    int fieldToValue(QStringView entry) const;
     bool mDirty;
 
-    QList<bool> mEnabled;
-    QList<bool> mInitialEnabled;
+    quint64 mEnabled;
+    quint64 mInitialEnabled;
 
     QString mInitialTokStr;
 
+    /**
+     * Whether mInitialTokStr starts with "*".
+     */
+    bool mInitialStarred;
+
 public:
     /**
      * Constant indicating short format.
@@ -9,8 +9,8 @@
 #include "ctvariable.h"
 
 #include <KLocalizedString>
-#include <QRegularExpression>
 
+#include "ctCronWriter.h"
 #include "ctHelper.h"
 
 CTVariable::CTVariable(const QString &tokenString, const QString &_comment, const QString &_userLogin)
@@ -24,7 +24,13 @@ CTVariable::CTVariable(const QString &tokenString, const QString &_comment, cons
         enabled = true;
     }
 
-    const int spacepos = tokStr.indexOf(QRegularExpression(QLatin1String("[ =]")));
+    int spacepos = -1;
+    for (int i = 0; i < tokStr.length(); ++i) {
+        if (tokStr.at(i) == QLatin1Char(' ') || tokStr.at(i) == QLatin1Char('=')) {
+            spacepos = i;
+            break;
+        }
+    }
     variable = tokStr.mid(0, spacepos);
 
     value = tokStr.mid(spacepos + 1, tokStr.length() - spacepos - 1);
@@ -75,15 +81,23 @@ CTVariable &CTVariable::operator=(const CTVariable &source)
 
 QString CTVariable::exportVariable()
 {
-    QString exportVariable = CTHelper::exportComment(comment);
+    QString exportVariable;
+
+    CTCronWriter writer(&exportVariable);
+    writeVariable(writer);
+
+    return exportVariable;
+}
+
+void CTVariable::writeVariable(CTCronWriter &writer) const
+{
+    CTHelper::writeComment(writer, comment);
 
     if (!enabled) {
-        exportVariable += QLatin1String("#\\");
+        writer << QLatin1String("#\\");
     }
 
-    exportVariable += variable + QLatin1String("=") + value + QLatin1String("\n");
-
-    return exportVariable;
+    writer << variable << QLatin1Char('=') << value << QLatin1Char('\n');
 }
 
 void CTVariable::apply()
@@ -11,6 +11,8 @@
 #include <QIcon>
 #include <QString>
 
+class CTCronWriter;
+
 /**
  * An environment variable (encapsulation of crontab environment variable
  * entry).  Encapsulates parsing and tokenization.
@@ -38,6 +40,11 @@ public:
      */
     QString exportVariable();
 
+    /**
+     * Writes the crontab format of the variable to @p writer.
+     */
+    void writeVariable(CTCronWriter &writer) const;
+
     /**
      * Mark changes as applied.
      */
@@ -11,21 +11,18 @@
 #include <QAction>
 #include <QHeaderView>
 #include <QKeyEvent>
+#include <QLabel>
+#include <QPushButton>
 #include <QVBoxLayout>
 
-#include "ctcron.h"
-#include "cttask.h"
-
 #include "crontabWidget.h"
-#include "taskEditorDialog.h"
-#include "taskWidget.h"
 
 #include "kcm_cron_debug.h"
 
 /**
  * Construct tasks folder from branch.
  */
-GenericListWidget::GenericListWidget(CrontabWidget *crontabWidget, const QString &label, const QIcon &icon)
+GenericListWidget::GenericListWidget(CrontabWidget *crontabWidget, const QString &label, const QIcon &icon, QTreeView *treeView)
     : QWidget(crontabWidget)
 {
     auto mainLayout = new QVBoxLayout(this);
@@ -48,28 +45,32 @@ GenericListWidget::GenericListWidget(CrontabWidget *crontabWidget, const QString
     // Tree layout
     auto treeLayout = new QHBoxLayout();
 
-    mTreeWidget = new QTreeWidget(this);
+    mTreeView = treeView;
+    mTreeView->setParent(this);
+
+    mTreeView->setRootIsDecorated(true);
+    mTreeView->setAllColumnsShowFocus(true);
 
-    mTreeWidget->setRootIsDecorated(true);
-    mTreeWidget->setAllColumnsShowFocus(true);
+    mTreeView->header()->setSortIndicatorShown(true);
+    mTreeView->header()->setStretchLastSection(true);
+    mTreeView->header()->setSectionsMovable(true);
 
-    mTreeWidget->header()->setSortIndicatorShown(true);
-    mTreeWidget->header()->setStretchLastSection(true);
-    mTreeWidget->header()->setSectionsMovable(true);
+    mTreeView->setSortingEnabled(true);
+    mTreeView->setAnimated(true);
 
-    mTreeWidget->setSortingEnabled(true);
-    mTreeWidget->setAnimated(true);
+    mTreeView->setRootIsDecorated(false);
 
-    mTreeWidget->setRootIsDecorated(false);
+    mTreeView->setAllColumnsShowFocus(true);
 
-    mTreeWidget->setAllColumnsShowFocus(true);
+    mTreeView->setAlternatingRowColors(true);
 
-    mTreeWidget->setAlternatingRowColors(true);
+    // Rows all have the same height, which lets the view skip measuring them.
+    mTreeView->setUniformRowHeights(true);
 
-    mTreeWidget->setSelectionMode(QAbstractItemView::ExtendedSelection);
-    mTreeWidget->setContextMenuPolicy(Qt::ActionsContextMenu);
+    mTreeView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    mTreeView->setContextMenuPolicy(Qt::ActionsContextMenu);
 
-    treeLayout->addWidget(mTreeWidget);
+    treeLayout->addWidget(mTreeView);
 
     mActionsLayout = new QVBoxLayout();
 
@@ -78,16 +79,15 @@ GenericListWidget::GenericListWidget(CrontabWidget *crontabWidget, const QString
     mainLayout->addLayout(treeLayout);
 
     qCDebug(KCM_CRON_LOG) << "Generic list created";
-    connect(treeWidget(), &QTreeWidget::itemDoubleClicked, this, &GenericListWidget::modifySelection);
 }
 
 GenericListWidget::~GenericListWidget()
 {
 }
 
-QTreeWidget *GenericListWidget::treeWidget() const
+QTreeView *GenericListWidget::treeView() const
 {
-    return mTreeWidget;
+    return mTreeView;
 }
 
 CrontabWidget *GenericListWidget::crontabWidget() const
@@ -103,21 +103,11 @@ CTHost *GenericListWidget::ctHost() const
 void GenericListWidget::resizeColumnContents()
 {
     // Resize all columns except the last one (which always take the last available space)
-    for (int i = 0, total = mTreeWidget->columnCount() - 1; i < total; ++i) {
-        mTreeWidget->resizeColumnToContents(i);
+    for (int i = 0, total = mTreeView->header()->count() - 1; i < total; ++i) {
+        mTreeView->resizeColumnToContents(i);
     }
 }
 
-QTreeWidgetItem *GenericListWidget::firstSelected() const
-{
-    const QList<QTreeWidgetItem *> tasksItems = treeWidget()->selectedItems();
-    if (tasksItems.isEmpty()) {
-        return nullptr;
-    }
-
-    return tasksItems.constFirst();
-}
-
 void GenericListWidget::keyPressEvent(QKeyEvent *e)
 {
     if (e->key() == Qt::Key_Delete) {
@@ -125,14 +115,6 @@ void GenericListWidget::keyPressEvent(QKeyEvent *e)
     }
 }
 
-void GenericListWidget::removeAll()
-{
-    // Remove previous items
-    for (int i = treeWidget()->topLevelItemCount() - 1; i >= 0; --i) {
-        delete treeWidget()->takeTopLevelItem(i);
-    }
-}
-
 QAction *GenericListWidget::createSeparator()
 {
     auto action = new QAction(this);
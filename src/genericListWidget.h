@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 
 #include "cthost.h"
 
@@ -26,11 +26,14 @@ class GenericListWidget : public QWidget
 {
     Q_OBJECT
 public:
-    explicit GenericListWidget(CrontabWidget *crontabWidget, const QString &label, const QIcon &icon);
+    /**
+     * Shows entries in @p treeView, created by the subclass.
+     */
+    explicit GenericListWidget(CrontabWidget *crontabWidget, const QString &label, const QIcon &icon, QTreeView *treeView);
 
     ~GenericListWidget() override;
 
-    QTreeWidget *treeWidget() const;
+    QTreeView *treeView() const;
 
     CTHost *ctHost() const;
 
@@ -41,15 +44,9 @@ public:
     void keyPressEvent(QKeyEvent *e) override;
 
 protected Q_SLOTS:
-    virtual void modifySelection(QTreeWidgetItem *item, int position) = 0;
-
     virtual void deleteSelection() = 0;
 
 protected:
-    void removeAll();
-
-    QTreeWidgetItem *firstSelected() const;
-
     QAction *createSeparator();
 
     void addRightAction(QAction *action, const QObject *receiver, const char *member);
@@ -58,7 +55,7 @@ protected:
     void setActionEnabled(QAction *action, bool enabled);
 
 private:
-    QTreeWidget *mTreeWidget = nullptr;
+    QTreeView *mTreeView = nullptr;
 
     CrontabWidget *mCrontabWidget = nullptr;
 
@@ -22,45 +22,384 @@
  *
  * ======================================================================== */
 
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef Q_OS_LINUX
+#include <sys/sendfile.h>
+#endif
 
 #include "kcm_cron_helper_debug.h"
 
 #include "kcronhelper.h"
 
+/**
+ * Only the system crontab and the fragments of /etc/cron.d may be written.
+ * @p fileName must already be cleaned, since it is the path written.
+ */
+static bool isSystemCrontab(const QString &fileName)
+{
+    if (fileName != QDir::cleanPath(fileName)) {
+        return false;
+    }
+
+    if (fileName == QLatin1String("/etc/crontab")) {
+        return true;
+    }
+
+    const QFileInfo fileInfo(fileName);
+    return fileInfo.path() == QLatin1String("/etc/cron.d") && !fileInfo.fileName().startsWith(QLatin1Char('.'));
+}
+
+static ActionReply errorReply(const QString &errorDescription)
+{
+    ActionReply reply = ActionReply::HelperErrorReply();
+    reply.setErrorDescription(errorDescription);
+    return reply;
+}
+
+/**
+ * Copies the rest of @p sourceFd to @p destinationFd through a buffer,
+ * where the kernel can't do it by itself.
+ */
+static bool copyThroughBuffer(int sourceFd, int destinationFd)
+{
+    char buffer[64 * 1024];
+
+    for (;;) {
+        const ssize_t readSize = read(sourceFd, buffer, sizeof(buffer));
+        if (readSize == 0) {
+            return true;
+        }
+
+        if (readSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        ssize_t writtenSize = 0;
+        while (writtenSize < readSize) {
+            const ssize_t written = write(destinationFd, buffer + writtenSize, readSize - writtenSize);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            writtenSize += written;
+        }
+    }
+}
+
+/**
+ * Copies the rest of @p sourceFd to @p destinationFd without going through
+ * the helper memory when possible.
+ */
+static bool copyFileContent(int sourceFd, int destinationFd)
+{
+#ifdef Q_OS_LINUX
+    // Largest amount the kernel copies at once.
+    const size_t chunkSize = 0x7ffff000;
+
+    // copy_file_range() may refuse to copy across file systems, as from /tmp to /etc.
+    bool copyFileRange = true;
+
+    for (;;) {
+        const ssize_t copied = copyFileRange ? copy_file_range(sourceFd, nullptr, destinationFd, nullptr, chunkSize, 0)
+                                             : sendfile(destinationFd, sourceFd, nullptr, chunkSize);
+        if (copied == 0) {
+            return true;
+        }
+
+        if (copied > 0) {
+            continue;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        // Nothing has been copied yet by the failing call, carry on from the same offset.
+        if (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP) {
+            if (copyFileRange) {
+                copyFileRange = false;
+                continue;
+            }
+            return copyThroughBuffer(sourceFd, destinationFd);
+        }
+
+        return false;
+    }
+#else
+    return copyThroughBuffer(sourceFd, destinationFd);
+#endif
+}
+
+/**
+ * Hidden path next to @p fileName, on the same file system so that rename()
+ * is atomic, and hidden since cron reads every file of /etc/cron.d.
+ */
+static QByteArray siblingTemplate(const QString &fileName, const char *suffix)
+{
+    const QFileInfo fileInfo(fileName);
+    return QFile::encodeName(fileInfo.path() + QLatin1String("/.") + fileInfo.fileName()) + suffix;
+}
+
+/**
+ * Copies @p source to a sibling temporary file of @p destination, ready to
+ * be renamed over it, and stores its path in @p temporaryPath.
+ *
+ * The copy keeps the mode and owner of @p destination, and is synced.
+ */
+static ActionReply stageCrontab(const QString &source, const QString &destination, QByteArray *temporaryPath)
+{
+    const int sourceFd = open(QFile::encodeName(source).constData(), O_RDONLY | O_CLOEXEC);
+    if (sourceFd < 0) {
+        qCWarning(KCM_CRON_HELPER_LOG) << "can't open source file for reading" << source << qt_error_string(errno);
+        return errorReply(qt_error_string(errno));
+    }
+
+    *temporaryPath = siblingTemplate(destination, ".kcron-XXXXXX");
+    const int temporaryFd = mkostemp(temporaryPath->data(), O_CLOEXEC);
+    if (temporaryFd < 0) {
+        const QString errorString = qt_error_string(errno);
+        qCWarning(KCM_CRON_HELPER_LOG) << "can't create temporary file next to" << destination << errorString;
+        close(sourceFd);
+        temporaryPath->clear();
+        return errorReply(errorString);
+    }
+
+    auto fail = [temporaryPath, sourceFd, temporaryFd](const char *step) {
+        const QString errorString = qt_error_string(errno);
+        qCWarning(KCM_CRON_HELPER_LOG) << step << "failed for" << *temporaryPath << errorString;
+        close(sourceFd);
+        close(temporaryFd);
+        unlink(temporaryPath->constData());
+        temporaryPath->clear();
+        return errorReply(errorString);
+    };
+
+    // cron skips crontabs writable by others, so keep the destination mode.
+    struct stat destinationStat;
+    if (stat(QFile::encodeName(destination).constData(), &destinationStat) == 0) {
+        if (fchown(temporaryFd, destinationStat.st_uid, destinationStat.st_gid) < 0) {
+            return fail("fchown");
+        }
+        if (fchmod(temporaryFd, destinationStat.st_mode & 07777) < 0) {
+            return fail("fchmod");
+        }
+    } else if (fchmod(temporaryFd, 0644) < 0) {
+        return fail("fchmod");
+    }
+
+    if (!copyFileContent(sourceFd, temporaryFd)) {
+        return fail("copy");
+    }
+
+    if (fsync(temporaryFd) < 0) {
+        return fail("fsync");
+    }
+
+    close(sourceFd);
+    if (close(temporaryFd) < 0) {
+        const QString errorString = qt_error_string(errno);
+        unlink(temporaryPath->constData());
+        temporaryPath->clear();
+        return errorReply(errorString);
+    }
+
+    return ActionReply::SuccessReply();
+}
+
+/**
+ * Makes the renames done in @p directory durable.
+ */
+static void syncDirectory(const QString &directory)
+{
+    const int directoryFd = open(QFile::encodeName(directory).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directoryFd >= 0) {
+        fsync(directoryFd);
+        close(directoryFd);
+    }
+}
+
 ActionReply KcronHelper::save(const QVariantMap &args)
 {
     qCDebug(KCM_CRON_HELPER_LOG) << "running actions";
 
-    QByteArray newCronData;
-    {
-        const QString source = args[QLatin1String("source")].toString();
-        QFile sourceFile(source);
-        if (!sourceFile.open(QIODevice::ReadOnly)) {
-            qCWarning(KCM_CRON_HELPER_LOG) << "can't open source file for reading" << source << sourceFile.errorString();
-            ActionReply reply = ActionReply::HelperErrorReply();
-            reply.setErrorDescription(sourceFile.errorString());
-            return reply;
+    // The checked path is the one written.
+    const QString destination = QDir::cleanPath(args.value(QStringLiteral("target"), QStringLiteral("/etc/crontab")).toString());
+    if (!isSystemCrontab(destination)) {
+        qCWarning(KCM_CRON_HELPER_LOG) << "refusing to write" << destination;
+        return errorReply(QStringLiteral("%1 is not a system crontab").arg(destination));
+    }
+
+    // Replaced at once, so that cron never reads a partially written crontab.
+    QByteArray temporaryPath;
+    const ActionReply stageReply = stageCrontab(args[QLatin1String("source")].toString(), destination, &temporaryPath);
+    if (stageReply.failed()) {
+        return stageReply;
+    }
+
+    if (rename(temporaryPath.constData(), QFile::encodeName(destination).constData()) < 0) {
+        const QString errorString = qt_error_string(errno);
+        qCWarning(KCM_CRON_HELPER_LOG) << "can't rename" << temporaryPath << "to" << destination << errorString;
+        unlink(temporaryPath.constData());
+        return errorReply(errorString);
+    }
+
+    syncDirectory(QFileInfo(destination).path());
+
+    return ActionReply::SuccessReply();
+}
+
+/**
+ * A crontab of a batch, staged next to its target.
+ */
+class StagedCrontab
+{
+public:
+    QString target;
+
+    QByteArray temporaryPath;
+
+    /**
+     * Hard link to the previous target, if it existed and has been replaced.
+     */
+    QByteArray backupPath;
+
+    bool replaced = false;
+};
+
+/**
+ * Puts back the targets of @p stagedCrontabs replaced so far, and removes
+ * the files staged for the others.
+ */
+static void rollBack(const QList<StagedCrontab> &stagedCrontabs)
+{
+    for (const StagedCrontab &stagedCrontab : stagedCrontabs) {
+        const QByteArray target = QFile::encodeName(stagedCrontab.target);
+
+        if (!stagedCrontab.replaced) {
+            if (!stagedCrontab.temporaryPath.isEmpty()) {
+                unlink(stagedCrontab.temporaryPath.constData());
+            }
+            if (!stagedCrontab.backupPath.isEmpty()) {
+                unlink(stagedCrontab.backupPath.constData());
+            }
+            continue;
+        }
+
+        // A target which did not exist before is removed.
+        const bool restored = stagedCrontab.backupPath.isEmpty() ? unlink(target.constData()) == 0
+                                                                 : rename(stagedCrontab.backupPath.constData(), target.constData()) == 0;
+        if (!restored) {
+            qCWarning(KCM_CRON_HELPER_LOG) << "can't restore" << stagedCrontab.target << qt_error_string(errno);
+        }
+    }
+}
+
+ActionReply KcronHelper::savebatch(const QVariantMap &args)
+{
+    qCDebug(KCM_CRON_HELPER_LOG) << "running batch actions";
+
+    const QVariantList manifest = args.value(QStringLiteral("manifest")).toList();
+
+    QList<StagedCrontab> stagedCrontabs;
+    QStringList sources;
+    for (const QVariant &entry : manifest) {
+        const QVariantMap entryMap = entry.toMap();
+
+        StagedCrontab stagedCrontab;
+        stagedCrontab.target = QDir::cleanPath(entryMap.value(QStringLiteral("target")).toString());
+        if (!isSystemCrontab(stagedCrontab.target)) {
+            qCWarning(KCM_CRON_HELPER_LOG) << "refusing to write" << stagedCrontab.target;
+            return errorReply(QStringLiteral("%1 is not a system crontab").arg(stagedCrontab.target));
+        }
+
+        const bool duplicate = std::any_of(stagedCrontabs.constBegin(), stagedCrontabs.constEnd(), [&stagedCrontab](const StagedCrontab &other) {
+            return other.target == stagedCrontab.target;
+        });
+        if (duplicate) {
+            return errorReply(QStringLiteral("%1 is written twice").arg(stagedCrontab.target));
         }
 
-        newCronData = sourceFile.readAll();
+        stagedCrontabs.append(stagedCrontab);
+        sources.append(entryMap.value(QStringLiteral("source")).toString());
     }
 
-    {
-        const QString destination = QStringLiteral("/etc/crontab");
-        QFile destinationFile(destination);
-        if (!destinationFile.open(QIODevice::WriteOnly)) {
-            ActionReply reply = ActionReply::HelperErrorReply();
-            qCWarning(KCM_CRON_HELPER_LOG) << "can't open destination file for writing" << destinationFile.errorString();
-            reply.setErrorDescription(destinationFile.errorString());
-            return reply;
+    // Copy every crontab first, nothing is replaced if one of them fails.
+    for (int i = 0; i < stagedCrontabs.count(); ++i) {
+        StagedCrontab &stagedCrontab = stagedCrontabs[i];
+
+        const ActionReply stageReply = stageCrontab(sources.at(i), stagedCrontab.target, &stagedCrontab.temporaryPath);
+        if (stageReply.failed()) {
+            rollBack(stagedCrontabs);
+            return stageReply;
         }
+    }
 
-        if (destinationFile.write(newCronData) < 0) {
-            ActionReply reply = ActionReply::HelperErrorReply();
-            qCWarning(KCM_CRON_HELPER_LOG) << "writing to destination file failed" << destinationFile.errorString();
-            reply.setErrorDescription(destinationFile.errorString());
+    // Keep the previous targets, to put them back if a rename fails.
+    for (StagedCrontab &stagedCrontab : stagedCrontabs) {
+        const QByteArray target = QFile::encodeName(stagedCrontab.target);
+        if (access(target.constData(), F_OK) < 0) {
+            continue;
         }
+
+        QByteArray backupPath = siblingTemplate(stagedCrontab.target, ".kcron-backup-XXXXXX");
+        const int backupFd = mkostemp(backupPath.data(), O_CLOEXEC);
+        if (backupFd < 0) {
+            const QString errorString = qt_error_string(errno);
+            rollBack(stagedCrontabs);
+            return errorReply(errorString);
+        }
+        close(backupFd);
+
+        // Only the name of the backup was needed.
+        if (unlink(backupPath.constData()) < 0 || link(target.constData(), backupPath.constData()) < 0) {
+            const QString errorString = qt_error_string(errno);
+            qCWarning(KCM_CRON_HELPER_LOG) << "can't back up" << stagedCrontab.target << errorString;
+            rollBack(stagedCrontabs);
+            return errorReply(errorString);
+        }
+        stagedCrontab.backupPath = backupPath;
+    }
+
+    for (StagedCrontab &stagedCrontab : stagedCrontabs) {
+        if (rename(stagedCrontab.temporaryPath.constData(), QFile::encodeName(stagedCrontab.target).constData()) < 0) {
+            const QString errorString = qt_error_string(errno);
+            qCWarning(KCM_CRON_HELPER_LOG) << "can't rename" << stagedCrontab.temporaryPath << "to" << stagedCrontab.target << errorString;
+            rollBack(stagedCrontabs);
+            return errorReply(errorString);
+        }
+        stagedCrontab.replaced = true;
+    }
+
+    QStringList directories;
+    for (const StagedCrontab &stagedCrontab : std::as_const(stagedCrontabs)) {
+        if (!stagedCrontab.backupPath.isEmpty()) {
+            unlink(stagedCrontab.backupPath.constData());
+        }
+
+        const QString directory = QFileInfo(stagedCrontab.target).path();
+        if (!directories.contains(directory)) {
+            directories.append(directory);
+        }
+    }
+
+    for (const QString &directory : std::as_const(directories)) {
+        syncDirectory(directory);
     }
 
     return ActionReply::SuccessReply();
@@ -38,4 +38,9 @@ class KcronHelper : public QObject
 
 public Q_SLOTS:
     ActionReply save(const QVariantMap &args);
+
+    /**
+     * Installs several system crontabs at once, or none of them.
+     */
+    ActionReply savebatch(const QVariantMap &args);
 };
@@ -13,11 +13,13 @@
 #include <KMessageBox>
 #include <KPluginFactory>
 #include <KStandardShortcut>
+#include <QFileInfo>
 #include <QVBoxLayout>
 
 #include "crontabWidget.h"
 
 #include "ctInitializationError.h"
+#include "ctSaveJob.h"
 #include "ctcron.h"
 #include "cthost.h"
 #include "cttask.h"
@@ -30,7 +32,8 @@ KCMCron::KCMCron(QObject *parent)
 {
     // Initialize document.
     CTInitializationError ctInitializationError;
-    mCtHost = new CTHost(findCrontabBinary(), ctInitializationError);
+    // Only the personal and system crons can be displayed, so read other users' crontabs on demand.
+    mCtHost = new CTHost(findCrontabBinary(), ctInitializationError, findCrontabSpoolDirectory(), true);
     if (ctInitializationError.hasErrorMessage()) {
         KMessageBox::error(widget(),
                            i18n("The following error occurred while initializing KCron:"
@@ -58,8 +61,26 @@ QString KCMCron::findCrontabBinary()
     return QStringLiteral(CRONTAB_BINARY);
 }
 
+QString KCMCron::findCrontabSpoolDirectory()
+{
+    // Debian, SUSE, then Red Hat and Arch. The first two also have /var/spool/cron.
+    const QStringList spoolDirectories{QStringLiteral("/var/spool/cron/crontabs"), QStringLiteral("/var/spool/cron/tabs"), QStringLiteral("/var/spool/cron")};
+    for (const QString &spoolDirectory : spoolDirectories) {
+        if (QFileInfo(spoolDirectory).isDir()) {
+            return spoolDirectory;
+        }
+    }
+
+    return QString();
+}
+
 KCMCron::~KCMCron()
 {
+    // The crons being saved are about to be deleted.
+    if (mSaveJob) {
+        mSaveJob->kill();
+    }
+
     delete mCrontabWidget;
     delete mCtHost;
 }
@@ -75,11 +96,30 @@ void KCMCron::save()
 {
     qCDebug(KCM_CRON_LOG) << "Saving crontab...";
 
-    CTSaveStatus saveStatus = mCtHost->save(mCrontabWidget);
-    if (saveStatus.isError()) {
-        KMessageBox::detailedError(widget(), saveStatus.errorMessage(), saveStatus.detailErrorMessage());
+    if (mSaveJob) {
+        return;
     }
-    qCDebug(KCM_CRON_LOG) << "saved ct host";
+
+    // Crontabs must not change until they are saved, which may take the time of an authorization.
+    mCrontabWidget->setEnabled(false);
+
+    // KCModule::save() would mark the changes as saved, they only are once the job finished.
+    setNeedsSave(true);
+
+    mSaveJob = mCtHost->createSaveJob(this);
+    connect(mSaveJob, &KJob::result, this, [this]() {
+        const CTSaveStatus saveStatus = mSaveJob->saveStatus();
+        mSaveJob = nullptr;
+
+        mCrontabWidget->setEnabled(true);
+
+        if (saveStatus.isError()) {
+            KMessageBox::detailedError(widget(), saveStatus.errorMessage(), saveStatus.detailErrorMessage());
+        }
+        setNeedsSave(mCtHost->isDirty());
+        qCDebug(KCM_CRON_LOG) << "saved ct host";
+    });
+    mSaveJob->start();
 }
 
 void KCMCron::defaults()
@@ -93,9 +133,12 @@ bool KCMCron::init()
 {
     // Display greeting screen.
     // If there currently are no scheduled tasks...
+    // Crontabs of other users which have not been read yet can't be displayed.
     int taskCount = 0;
     for (CTCron *ctCron : std::as_const(mCtHost->mCrons)) {
-        taskCount += ctCron->tasks().count();
+        if (ctCron->isLoaded()) {
+            taskCount += ctCron->tasks().count();
+        }
     }
 
     if (taskCount == 0) {
@@ -22,6 +22,7 @@
 #include <KSharedConfig>
 
 class CTHost;
+class CTSaveJob;
 class CrontabWidget;
 
 class KCMCron : public KCModule
@@ -49,6 +50,11 @@ public:
 
     QString findCrontabBinary();
 
+    /**
+     * Cron daemon spool directory, where user crontabs are stored.
+     */
+    QString findCrontabSpoolDirectory();
+
 private:
     /**
      * Main GUI view/working area.
@@ -59,5 +65,10 @@ private:
      * Document object, here crotab entries.
      */
     CTHost *mCtHost = nullptr;
+
+    /**
+     * Save in progress, if any.
+     */
+    CTSaveJob *mSaveJob = nullptr;
 };
 
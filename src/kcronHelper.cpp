@@ -28,6 +28,11 @@ void KCronHelper::initUserCombo(QComboBox *userCombo, CrontabWidget *crontabWidg
     int selectedIndex = 0;
     const auto crons = crontabWidget->ctHost()->mCrons;
     for (CTCron *ctCron : crons) {
+        // The /etc/cron.d fragments are system crons too.
+        if (ctCron->isSystemCron() && ctCron != crontabWidget->ctHost()->findSystemCron()) {
+            continue;
+        }
+
         users.append(ctCron->userLogin());
 
         if (ctCron->userLogin() == selectedUserLogin) {
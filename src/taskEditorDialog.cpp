@@ -29,6 +29,7 @@
 #include <QPushButton>
 #include <kurlrequester.h>
 
+#include "ctCommandIconCache.h"
 #include "cttask.h"
 #include "kcm_cron_debug.h"
 
@@ -194,6 +195,8 @@ TaskEditorDialog::TaskEditorDialog(CTTask *_ctTask, const QString &_caption, Cro
     connect(buttonBox, &QDialogButtonBox::accepted, this, &TaskEditorDialog::slotOK);
     connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
 
+    connect(mCrontabWidget->commandIconCache(), &CTCommandIconCache::iconResolved, this, &TaskEditorDialog::slotCommandIconResolved);
+
     if (!mChkEnabled->isChecked()) {
         slotEnabledChanged();
     } else if (mChkReboot->isChecked()) {
@@ -700,7 +703,22 @@ void TaskEditorDialog::defineCommandIcon()
     CTTask tempTask(*mCtTask);
     tempTask.command = mCommand->url().path();
 
-    mCommandIcon->setPixmap(tempTask.commandIcon().pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize, nullptr, this)));
+    mCommandIcon->setPixmap(tempTask.commandIcon(mCrontabWidget->commandIconCache()).pixmap(style()->pixelMetric(QStyle::PM_SmallIconSize, nullptr, this)));
+}
+
+void TaskEditorDialog::slotCommandIconResolved(const QString &commandPath)
+{
+    // The icon is only shown for valid tasks.
+    if (!mOkButton->isEnabled()) {
+        return;
+    }
+
+    CTTask tempTask(*mCtTask);
+    tempTask.command = mCommand->url().path();
+
+    if (tempTask.completeCommandPath() == commandPath) {
+        defineCommandIcon();
+    }
 }
 
 bool TaskEditorDialog::checkCommand()
@@ -82,6 +82,11 @@ public:
 
 private Q_SLOTS:
 
+    /**
+     * The icon of a command has been found.
+     */
+    void slotCommandIconResolved(const QString &commandPath);
+
     /**
      * Control the task title bar.
      */
@@ -0,0 +1,209 @@
+/*
+    KT tasks model.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "tasksModel.h"
+
+#include <KLocalizedString>
+
+#include "ctCommandIconCache.h"
+#include "ctcron.h"
+#include "cttask.h"
+
+TasksModel::TasksModel(CTCommandIconCache *commandIconCache, QObject *parent)
+    : QAbstractTableModel(parent)
+    , mCommandIconCache(commandIconCache)
+    , mEnabledIcon(QIcon::fromTheme(QStringLiteral("dialog-ok-apply")))
+    , mDisabledIcon(QIcon::fromTheme(QStringLiteral("dialog-cancel")))
+{
+    connect(mCommandIconCache, &CTCommandIconCache::iconResolved, this, &TasksModel::refreshCommandIcons);
+}
+
+TasksModel::~TasksModel()
+{
+}
+
+void TasksModel::setCron(CTCron *cron)
+{
+    beginResetModel();
+
+    mCron = cron;
+    mPendingIconRows.clear();
+    if (mCron) {
+        mTasks = mCron->tasks();
+        mUserColumn = mCron->isMultiUserCron();
+    } else {
+        mTasks.clear();
+        mUserColumn = false;
+    }
+
+    endResetModel();
+}
+
+bool TasksModel::hasUserColumn() const
+{
+    return mUserColumn;
+}
+
+int TasksModel::statusColumn() const
+{
+    return mUserColumn ? StatusColumn : StatusColumn - 1;
+}
+
+TasksModel::Column TasksModel::columnAt(int section) const
+{
+    return static_cast<Column>(mUserColumn ? section : section + 1);
+}
+
+CTTask *TasksModel::task(const QModelIndex &index) const
+{
+    if (!index.isValid() || index.row() >= mTasks.count()) {
+        return nullptr;
+    }
+
+    return mTasks.at(index.row());
+}
+
+void TasksModel::addTask(CTTask *task)
+{
+    const int row = mTasks.count();
+
+    beginInsertRows(QModelIndex(), row, row);
+    mTasks.append(task);
+    endInsertRows();
+}
+
+void TasksModel::refreshTask(CTTask *task)
+{
+    const int row = mTasks.indexOf(task);
+    if (row == -1) {
+        return;
+    }
+
+    Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
+void TasksModel::removeTask(CTTask *task)
+{
+    const int row = mTasks.indexOf(task);
+    if (row == -1) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    mTasks.removeAt(row);
+    mPendingIconRows.clear();
+    endRemoveRows();
+}
+
+void TasksModel::refreshCommandIcons(const QString &commandPath)
+{
+    const QList<int> rows = mPendingIconRows.take(commandPath);
+
+    const int commandColumn = mUserColumn ? CommandColumn : CommandColumn - 1;
+    for (int row : rows) {
+        const QModelIndex commandIndex = index(row, commandColumn);
+        Q_EMIT dataChanged(commandIndex, commandIndex, {Qt::DecorationRole});
+    }
+}
+
+int TasksModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return mTasks.count();
+}
+
+int TasksModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return mUserColumn ? ColumnCount : ColumnCount - 1;
+}
+
+QVariant TasksModel::data(const QModelIndex &index, int role) const
+{
+    const CTTask *ctTask = task(index);
+    if (!ctTask) {
+        return QVariant();
+    }
+
+    const Column column = columnAt(index.column());
+
+    if (role == Qt::DisplayRole) {
+        switch (column) {
+        case UserColumn:
+            return ctTask->userLogin;
+        case SchedulingColumn:
+            return ctTask->schedulingCronFormat();
+        case CommandColumn:
+            return ctTask->command;
+        case StatusColumn:
+            return ctTask->enabled ? i18n("Enabled") : i18n("Disabled");
+        case CommentColumn:
+            return ctTask->comment;
+        case DescriptionColumn:
+            return ctTask->describe();
+        case ColumnCount:
+            break;
+        }
+    } else if (role == Qt::DecorationRole) {
+        if (column == CommandColumn) {
+            const QString commandPath = ctTask->completeCommandPath();
+
+            bool resolved;
+            const QIcon icon = mCommandIconCache->icon(commandPath, &resolved);
+            if (!resolved) {
+                QList<int> &rows = mPendingIconRows[commandPath];
+                if (!rows.contains(index.row())) {
+                    rows.append(index.row());
+                }
+            }
+
+            return icon;
+        }
+
+        if (column == StatusColumn) {
+            return ctTask->enabled ? mEnabledIcon : mDisabledIcon;
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant TasksModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (columnAt(section)) {
+    case UserColumn:
+        return i18n("User");
+    case SchedulingColumn:
+        return i18n("Scheduling");
+    case CommandColumn:
+        return i18n("Command");
+    case StatusColumn:
+        return i18n("Status");
+    case CommentColumn:
+        return i18n("Description");
+    case DescriptionColumn:
+        return i18n("Scheduling Details");
+    case ColumnCount:
+        break;
+    }
+
+    return QVariant();
+}
+
+#include "moc_tasksModel.cpp"
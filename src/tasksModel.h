@@ -0,0 +1,104 @@
+/*
+    KT tasks model.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QIcon>
+#include <QList>
+
+class CTCommandIconCache;
+class CTCron;
+class CTTask;
+
+/**
+ * Table of the tasks of a cron.
+ *
+ * Cells are only computed when the view asks for them, that is for the
+ * visible rows, so that crons with many tasks are shown at once.
+ */
+class TasksModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit TasksModel(CTCommandIconCache *commandIconCache, QObject *parent = nullptr);
+
+    ~TasksModel() override;
+
+    /**
+     * Shows the tasks of @p cron, or nothing.
+     */
+    void setCron(CTCron *cron);
+
+    /**
+     * Indicates whether the cron has tasks of several users, shown in a first column.
+     */
+    bool hasUserColumn() const;
+
+    int statusColumn() const;
+
+    /**
+     * Task of the row of @p index, or nullptr.
+     */
+    CTTask *task(const QModelIndex &index) const;
+
+    /**
+     * Tell the model about tasks added to, modified in or removed from the cron.
+     */
+    void addTask(CTTask *task);
+    void refreshTask(CTTask *task);
+    void removeTask(CTTask *task);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private Q_SLOTS:
+    /**
+     * The icon of the command at @p commandPath has been found.
+     */
+    void refreshCommandIcons(const QString &commandPath);
+
+private:
+    /**
+     * Columns, the user one being only shown for multi-user crons.
+     */
+    enum Column {
+        UserColumn,
+        SchedulingColumn,
+        CommandColumn,
+        StatusColumn,
+        CommentColumn,
+        DescriptionColumn,
+        ColumnCount,
+    };
+
+    Column columnAt(int section) const;
+
+    CTCron *mCron = nullptr;
+
+    CTCommandIconCache *mCommandIconCache = nullptr;
+
+    /**
+     * Rows shown with a placeholder icon, by command path, to only refresh
+     * them once the icon is found.  Forgotten when rows move, since views
+     * ask for the icons of the rows they show again.
+     */
+    mutable QHash<QString, QList<int>> mPendingIconRows;
+
+    QList<CTTask *> mTasks;
+
+    bool mUserColumn = false;
+
+    QIcon mEnabledIcon;
+    QIcon mDisabledIcon;
+};
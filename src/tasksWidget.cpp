@@ -11,6 +11,7 @@
 #include <QAction>
 #include <QList>
 #include <QProcess>
+#include <QSortFilterProxyModel>
 
 #include <KLocalizedString>
 #include <KStandardAction>
@@ -21,7 +22,7 @@
 
 #include "crontabWidget.h"
 #include "taskEditorDialog.h"
-#include "taskWidget.h"
+#include "tasksModel.h"
 
 #include "kcm_cron_debug.h"
 
@@ -29,16 +30,21 @@
  * Construct tasks folder from branch.
  */
 TasksWidget::TasksWidget(CrontabWidget *crontabWidget)
-    : GenericListWidget(crontabWidget, i18n("<b>Scheduled Tasks</b>"), QIcon::fromTheme(QStringLiteral("system-run")))
+    : GenericListWidget(crontabWidget, i18n("<b>Scheduled Tasks</b>"), QIcon::fromTheme(QStringLiteral("system-run")), new QTreeView())
 {
-    refreshHeaders();
+    mTasksModel = new TasksModel(crontabWidget->commandIconCache(), this);
 
-    treeWidget()->sortItems(1, Qt::AscendingOrder);
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mTasksModel);
+
+    treeView()->setModel(mProxyModel);
+    treeView()->sortByColumn(1, Qt::AscendingOrder);
 
     setupActions(crontabWidget);
     prepareContextualMenu();
 
-    connect(treeWidget(), &QTreeWidget::itemSelectionChanged, this, &TasksWidget::changeCurrentSelection);
+    connect(treeView()->selectionModel(), &QItemSelectionModel::selectionChanged, this, &TasksWidget::changeCurrentSelection);
+    connect(treeView(), &QTreeView::doubleClicked, this, static_cast<void (TasksWidget::*)(const QModelIndex &)>(&TasksWidget::modifySelection));
 
     qCDebug(KCM_CRON_LOG) << "Tasks list created";
 }
@@ -47,43 +53,33 @@ TasksWidget::~TasksWidget()
 {
 }
 
-QList<TaskWidget *> TasksWidget::selectedTasksWidget() const
+QList<CTTask *> TasksWidget::selectedTasks() const
 {
-    QList<TaskWidget *> tasksWidget;
+    QList<CTTask *> tasks;
 
-    const QList<QTreeWidgetItem *> tasksItems = treeWidget()->selectedItems();
-    tasksWidget.reserve(tasksItems.count());
-    for (QTreeWidgetItem *item : tasksItems) {
-        auto taskWidget = static_cast<TaskWidget *>(item);
-        tasksWidget.append(taskWidget);
+    const QModelIndexList selectedRows = treeView()->selectionModel()->selectedRows();
+    tasks.reserve(selectedRows.count());
+    for (const QModelIndex &index : selectedRows) {
+        tasks.append(mTasksModel->task(mProxyModel->mapToSource(index)));
     }
 
-    return tasksWidget;
+    return tasks;
 }
 
-TaskWidget *TasksWidget::firstSelectedTaskWidget() const
+CTTask *TasksWidget::firstSelectedTask() const
 {
-    QTreeWidgetItem *item = firstSelected();
-    if (!item) {
+    const QModelIndexList selectedRows = treeView()->selectionModel()->selectedRows();
+    if (selectedRows.isEmpty()) {
         return nullptr;
     }
 
-    return static_cast<TaskWidget *>(item);
-}
-
-int TasksWidget::statusColumnIndex()
-{
-    if (needUserColumn()) {
-        return 3;
-    }
-
-    return 2;
+    return mTasksModel->task(mProxyModel->mapToSource(selectedRows.constFirst()));
 }
 
 void TasksWidget::runTaskNow() const
 {
-    TaskWidget *taskWidget = firstSelectedTaskWidget();
-    if (taskWidget == nullptr) {
+    CTTask *task = firstSelectedTask();
+    if (task == nullptr) {
         return;
     }
 
@@ -93,7 +89,7 @@ void TasksWidget::runTaskNow() const
         return;
     }
 
-    const QString taskCommand = taskWidget->getCTTask()->command;
+    const QString taskCommand = task->command;
 
     const QString echoMessage = i18nc("Do not use any quote characters (') in this string", "End of script execution. Type Enter or Ctrl+C to exit.");
     QStringList commandList;
@@ -143,52 +139,61 @@ void TasksWidget::addTask(CTTask *task)
     CTCron *cron = crontabWidget()->currentCron();
 
     cron->addTask(task);
-    new TaskWidget(this, task);
+    mTasksModel->addTask(task);
 }
 
 void TasksWidget::modifySelection()
 {
-    modifySelection(firstSelectedTaskWidget(), -1);
+    CTTask *task = firstSelectedTask();
+    if (task) {
+        modifyTask(task);
+    }
+
+    qCDebug(KCM_CRON_LOG) << "End of modification";
 }
 
-void TasksWidget::modifySelection(QTreeWidgetItem *item, int position)
+void TasksWidget::modifySelection(const QModelIndex &index)
 {
-    auto taskWidget = static_cast<TaskWidget *>(item);
-    if (taskWidget) {
-        if (position == statusColumnIndex()) {
-            taskWidget->toggleEnable();
+    const QModelIndex sourceIndex = mProxyModel->mapToSource(index);
+    CTTask *task = mTasksModel->task(sourceIndex);
+    if (task) {
+        if (sourceIndex.column() == mTasksModel->statusColumn()) {
+            task->enabled = !task->enabled;
+            crontabWidget()->currentCron()->modifyTask(task);
+            mTasksModel->refreshTask(task);
             Q_EMIT taskModified(true);
         } else {
-            CTTask *task = taskWidget->getCTTask();
-            TaskEditorDialog taskEditorDialog(task, i18n("Modify Task"), crontabWidget());
-            int result = taskEditorDialog.exec();
-
-            if (result == QDialog::Accepted) {
-                crontabWidget()->currentCron()->modifyTask(task);
-                taskWidget->refresh();
-                Q_EMIT taskModified(true);
-            }
+            modifyTask(task);
         }
     }
 
     qCDebug(KCM_CRON_LOG) << "End of modification";
 }
 
+void TasksWidget::modifyTask(CTTask *task)
+{
+    TaskEditorDialog taskEditorDialog(task, i18n("Modify Task"), crontabWidget());
+    int result = taskEditorDialog.exec();
+
+    if (result == QDialog::Accepted) {
+        crontabWidget()->currentCron()->modifyTask(task);
+        mTasksModel->refreshTask(task);
+        Q_EMIT taskModified(true);
+    }
+}
+
 void TasksWidget::deleteSelection()
 {
     qCDebug(KCM_CRON_LOG) << "Selection deleting...";
 
-    const QList<QTreeWidgetItem *> tasksItems = treeWidget()->selectedItems();
-
-    bool deleteSomething = !(tasksItems.isEmpty());
+    const QList<CTTask *> tasks = selectedTasks();
 
-    for (QTreeWidgetItem *item : tasksItems) {
-        auto taskWidget = static_cast<TaskWidget *>(item);
+    bool deleteSomething = !(tasks.isEmpty());
 
-        crontabWidget()->currentCron()->removeTask(taskWidget->getCTTask());
-        delete taskWidget->getCTTask();
-        treeWidget()->takeTopLevelItem(treeWidget()->indexOfTopLevelItem(taskWidget));
-        delete taskWidget;
+    for (CTTask *task : tasks) {
+        crontabWidget()->currentCron()->removeTask(task);
+        mTasksModel->removeTask(task);
+        delete task;
     }
 
     if (deleteSomething) {
@@ -201,41 +206,19 @@ void TasksWidget::deleteSelection()
 
 void TasksWidget::refreshTasks(CTCron *cron)
 {
-    // Remove previous items
-    removeAll();
-
-    refreshHeaders();
-
-    // Add new items
-    const auto tasks = cron->tasks();
-    for (CTTask *ctTask : tasks) {
-        new TaskWidget(this, ctTask);
-    }
+    mTasksModel->setCron(cron);
 
     resizeColumnContents();
 }
 
-void TasksWidget::refreshHeaders()
+void TasksWidget::refreshTasks(const CTCronChanges &changes)
 {
-    QStringList headerLabels;
-
-    if (needUserColumn()) {
-        headerLabels << i18n("User");
+    for (CTTask *task : changes.removedTasks) {
+        mTasksModel->removeTask(task);
     }
 
-    headerLabels << i18n("Scheduling");
-
-    headerLabels << i18n("Command");
-    headerLabels << i18n("Status");
-    headerLabels << i18n("Description");
-    headerLabels << i18n("Scheduling Details");
-
-    treeWidget()->setHeaderLabels(headerLabels);
-
-    if (needUserColumn()) {
-        treeWidget()->setColumnCount(6);
-    } else {
-        treeWidget()->setColumnCount(5);
+    for (CTTask *task : changes.addedTasks) {
+        mTasksModel->addTask(task);
     }
 }
 
@@ -283,23 +266,23 @@ void TasksWidget::setupActions(CrontabWidget *crontabWidget)
 
 void TasksWidget::prepareContextualMenu()
 {
-    treeWidget()->addAction(mNewTaskAction);
+    treeView()->addAction(mNewTaskAction);
 
-    treeWidget()->addAction(createSeparator());
+    treeView()->addAction(createSeparator());
 
-    treeWidget()->addAction(mModifyAction);
-    treeWidget()->addAction(mDeleteAction);
+    treeView()->addAction(mModifyAction);
+    treeView()->addAction(mDeleteAction);
 
-    treeWidget()->addAction(createSeparator());
+    treeView()->addAction(createSeparator());
     const auto cutCopyPasteActions = crontabWidget()->cutCopyPasteActions();
 
     for (QAction *action : cutCopyPasteActions) {
-        treeWidget()->addAction(action);
+        treeView()->addAction(action);
     }
 
-    treeWidget()->addAction(createSeparator());
+    treeView()->addAction(createSeparator());
 
-    treeWidget()->addAction(mRunNowAction);
+    treeView()->addAction(mRunNowAction);
 }
 
 void TasksWidget::toggleRunNowAction(bool state)
@@ -327,14 +310,14 @@ void TasksWidget::changeCurrentSelection()
 {
     // qCDebug(KCM_CRON_LOG) << "Change selection...";
 
-    if (treeWidget()->topLevelItemCount() == 0) {
+    if (mTasksModel->rowCount() == 0) {
         togglePrintAction(false);
     } else {
         togglePrintAction(true);
     }
 
     bool enabled;
-    if (treeWidget()->selectedItems().isEmpty()) {
+    if (!treeView()->selectionModel()->hasSelection()) {
         enabled = false;
     } else {
         enabled = true;
@@ -8,15 +8,17 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 
 #include "cthost.h"
 #include "genericListWidget.h"
 
-class TaskWidget;
+class CTCronChanges;
+class QSortFilterProxyModel;
+class TasksModel;
 
 /**
- * QTreeWidget of a "tasks" folder.
+ * QTreeView of a "tasks" folder.
  */
 class TasksWidget : public GenericListWidget
 {
@@ -30,12 +32,17 @@ public:
 
     ~TasksWidget() override;
 
-    TaskWidget *firstSelectedTaskWidget() const;
+    CTTask *firstSelectedTask() const;
 
-    QList<TaskWidget *> selectedTasksWidget() const;
+    QList<CTTask *> selectedTasks() const;
 
     void refreshTasks(CTCron *cron);
 
+    /**
+     * Only updates the rows of the tasks replaced by CTCron::reload().
+     */
+    void refreshTasks(const CTCronChanges &changes);
+
     bool needUserColumn() const;
 
     /**
@@ -81,12 +88,13 @@ public Q_SLOTS:
     void changeCurrentSelection();
 
 protected Q_SLOTS:
-    void modifySelection(QTreeWidgetItem *item, int position) override;
+    void modifySelection(const QModelIndex &index);
 
 private:
-    void refreshHeaders();
-
-    int statusColumnIndex();
+    /**
+     * Opens the task editor on @p task.
+     */
+    void modifyTask(CTTask *task);
 
     void setupActions(CrontabWidget *crontabWidget);
     void prepareContextualMenu();
@@ -100,5 +108,9 @@ private:
     QAction *mRunNowAction = nullptr;
 
     QAction *mPrintAction = nullptr;
+
+    TasksModel *mTasksModel = nullptr;
+
+    QSortFilterProxyModel *mProxyModel = nullptr;
 };
 
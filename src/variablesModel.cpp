@@ -0,0 +1,179 @@
+/*
+    KT variables model.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "variablesModel.h"
+
+#include <KLocalizedString>
+
+#include "ctcron.h"
+#include "ctvariable.h"
+
+VariablesModel::VariablesModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , mEnabledIcon(QIcon::fromTheme(QStringLiteral("dialog-ok-apply")))
+    , mDisabledIcon(QIcon::fromTheme(QStringLiteral("dialog-cancel")))
+{
+}
+
+VariablesModel::~VariablesModel()
+{
+}
+
+void VariablesModel::setCron(CTCron *cron)
+{
+    beginResetModel();
+
+    mCron = cron;
+    if (mCron) {
+        mVariables = mCron->variables();
+        // The system cron only has variables of root.
+        mUserColumn = mCron->isMultiUserCron() && !mCron->isSystemCron();
+    } else {
+        mVariables.clear();
+        mUserColumn = false;
+    }
+
+    endResetModel();
+}
+
+bool VariablesModel::hasUserColumn() const
+{
+    return mUserColumn;
+}
+
+int VariablesModel::statusColumn() const
+{
+    return mUserColumn ? StatusColumn : StatusColumn - 1;
+}
+
+VariablesModel::Column VariablesModel::columnAt(int section) const
+{
+    return static_cast<Column>(mUserColumn ? section : section + 1);
+}
+
+CTVariable *VariablesModel::variable(const QModelIndex &index) const
+{
+    if (!index.isValid() || index.row() >= mVariables.count()) {
+        return nullptr;
+    }
+
+    return mVariables.at(index.row());
+}
+
+void VariablesModel::addVariable(CTVariable *variable)
+{
+    const int row = mVariables.count();
+
+    beginInsertRows(QModelIndex(), row, row);
+    mVariables.append(variable);
+    endInsertRows();
+}
+
+void VariablesModel::refreshVariable(CTVariable *variable)
+{
+    const int row = mVariables.indexOf(variable);
+    if (row == -1) {
+        return;
+    }
+
+    Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
+void VariablesModel::removeVariable(CTVariable *variable)
+{
+    const int row = mVariables.indexOf(variable);
+    if (row == -1) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    mVariables.removeAt(row);
+    endRemoveRows();
+}
+
+int VariablesModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return mVariables.count();
+}
+
+int VariablesModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return mUserColumn ? ColumnCount : ColumnCount - 1;
+}
+
+QVariant VariablesModel::data(const QModelIndex &index, int role) const
+{
+    const CTVariable *ctVariable = variable(index);
+    if (!ctVariable) {
+        return QVariant();
+    }
+
+    const Column column = columnAt(index.column());
+
+    if (role == Qt::DisplayRole) {
+        switch (column) {
+        case UserColumn:
+            return ctVariable->userLogin;
+        case VariableColumn:
+            return ctVariable->variable;
+        case ValueColumn:
+            return ctVariable->value;
+        case StatusColumn:
+            return ctVariable->enabled ? i18n("Enabled") : i18n("Disabled");
+        case CommentColumn:
+            return ctVariable->comment;
+        case ColumnCount:
+            break;
+        }
+    } else if (role == Qt::DecorationRole) {
+        if (column == VariableColumn) {
+            return ctVariable->variableIcon();
+        }
+
+        if (column == StatusColumn) {
+            return ctVariable->enabled ? mEnabledIcon : mDisabledIcon;
+        }
+    }
+
+    return QVariant();
+}
+
+QVariant VariablesModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (columnAt(section)) {
+    case UserColumn:
+        return i18n("User");
+    case VariableColumn:
+        return i18n("Variable");
+    case ValueColumn:
+        return i18n("Value");
+    case StatusColumn:
+        return i18n("Status");
+    case CommentColumn:
+        return i18n("Comment");
+    case ColumnCount:
+        break;
+    }
+
+    return QVariant();
+}
+
+#include "moc_variablesModel.cpp"
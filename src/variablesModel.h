@@ -0,0 +1,86 @@
+/*
+    KT variables model.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 1999 Gary Meyer <gary@meyer.net>
+    SPDX-FileCopyrightText: 2026 KCron Developers
+    --------------------------------------------------------------------
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QIcon>
+#include <QList>
+
+class CTCron;
+class CTVariable;
+
+/**
+ * Table of the environment variables of a cron.
+ *
+ * Cells are only computed when the view asks for them, and a modified
+ * variable only refreshes its own row.
+ */
+class VariablesModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit VariablesModel(QObject *parent = nullptr);
+
+    ~VariablesModel() override;
+
+    /**
+     * Shows the variables of @p cron, or nothing.
+     */
+    void setCron(CTCron *cron);
+
+    /**
+     * Indicates whether the cron has variables of several users, shown in a first column.
+     */
+    bool hasUserColumn() const;
+
+    int statusColumn() const;
+
+    /**
+     * Variable of the row of @p index, or nullptr.
+     */
+    CTVariable *variable(const QModelIndex &index) const;
+
+    /**
+     * Tell the model about variables added to, modified in or removed from the cron.
+     */
+    void addVariable(CTVariable *variable);
+    void refreshVariable(CTVariable *variable);
+    void removeVariable(CTVariable *variable);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    /**
+     * Columns, the user one being only shown for multi-user crons.
+     */
+    enum Column {
+        UserColumn,
+        VariableColumn,
+        ValueColumn,
+        StatusColumn,
+        CommentColumn,
+        ColumnCount,
+    };
+
+    Column columnAt(int section) const;
+
+    CTCron *mCron = nullptr;
+
+    QList<CTVariable *> mVariables;
+
+    bool mUserColumn = false;
+
+    QIcon mEnabledIcon;
+    QIcon mDisabledIcon;
+};
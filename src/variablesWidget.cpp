@@ -10,6 +10,7 @@
 
 #include <QAction>
 #include <QList>
+#include <QSortFilterProxyModel>
 
 #include <KLocalizedString>
 #include <QIcon>
@@ -19,23 +20,28 @@
 
 #include "crontabWidget.h"
 #include "variableEditorDialog.h"
-#include "variableWidget.h"
+#include "variablesModel.h"
 
 #include "kcm_cron_debug.h"
 /**
  * Construct tasks folder from branch.
  */
 VariablesWidget::VariablesWidget(CrontabWidget *crontabWidget)
-    : GenericListWidget(crontabWidget, i18n("<b>Environment Variables</b>"), QIcon::fromTheme(QStringLiteral("text-plain")))
+    : GenericListWidget(crontabWidget, i18n("<b>Environment Variables</b>"), QIcon::fromTheme(QStringLiteral("text-plain")), new QTreeView())
 {
-    refreshHeaders();
+    mVariablesModel = new VariablesModel(this);
 
-    treeWidget()->sortItems(0, Qt::AscendingOrder);
+    mProxyModel = new QSortFilterProxyModel(this);
+    mProxyModel->setSourceModel(mVariablesModel);
+
+    treeView()->setModel(mProxyModel);
+    treeView()->sortByColumn(0, Qt::AscendingOrder);
 
     setupActions();
     prepareContextualMenu();
 
-    connect(treeWidget(), &QTreeWidget::itemSelectionChanged, this, &VariablesWidget::changeCurrentSelection);
+    connect(treeView()->selectionModel(), &QItemSelectionModel::selectionChanged, this, &VariablesWidget::changeCurrentSelection);
+    connect(treeView(), &QTreeView::doubleClicked, this, static_cast<void (VariablesWidget::*)(const QModelIndex &)>(&VariablesWidget::modifySelection));
 
     qCDebug(KCM_CRON_LOG) << "Variables list created";
 }
@@ -46,68 +52,75 @@ VariablesWidget::~VariablesWidget()
 
 void VariablesWidget::modifySelection()
 {
-    modifySelection(firstSelectedVariableWidget(), -1);
+    CTVariable *variable = firstSelectedVariable();
+    if (variable) {
+        modifyVariable(variable);
+    }
 }
 
-void VariablesWidget::modifySelection(QTreeWidgetItem *item, int position)
+void VariablesWidget::modifySelection(const QModelIndex &index)
 {
-    auto variableWidget = static_cast<VariableWidget *>(item);
-
-    if (variableWidget) {
-        if (position == statusColumnIndex()) {
-            variableWidget->toggleEnable();
-            Q_EMIT variableModified(true);
-        } else {
-            CTVariable *variable = variableWidget->getCTVariable();
-            VariableEditorDialog variableEditorDialog(variable, i18n("Modify Variable"), crontabWidget());
-            int result = variableEditorDialog.exec();
-
-            if (result == QDialog::Accepted) {
-                crontabWidget()->currentCron()->modifyVariable(variable);
-                variableWidget->refresh();
-
-                Q_EMIT variableModified(true);
-            }
-        }
+    const QModelIndex sourceIndex = mProxyModel->mapToSource(index);
+    CTVariable *variable = mVariablesModel->variable(sourceIndex);
+    if (!variable) {
+        return;
+    }
+
+    if (sourceIndex.column() == mVariablesModel->statusColumn()) {
+        variable->enabled = !variable->enabled;
+        crontabWidget()->currentCron()->modifyVariable(variable);
+        mVariablesModel->refreshVariable(variable);
+        Q_EMIT variableModified(true);
+    } else {
+        modifyVariable(variable);
+    }
+}
+
+void VariablesWidget::modifyVariable(CTVariable *variable)
+{
+    VariableEditorDialog variableEditorDialog(variable, i18n("Modify Variable"), crontabWidget());
+    int result = variableEditorDialog.exec();
+
+    if (result == QDialog::Accepted) {
+        crontabWidget()->currentCron()->modifyVariable(variable);
+        mVariablesModel->refreshVariable(variable);
+
+        Q_EMIT variableModified(true);
     }
 }
 
-QList<VariableWidget *> VariablesWidget::selectedVariablesWidget() const
+QList<CTVariable *> VariablesWidget::selectedVariables() const
 {
-    QList<VariableWidget *> variablesWidget;
+    QList<CTVariable *> variables;
 
-    const QList<QTreeWidgetItem *> variablesItems = treeWidget()->selectedItems();
-    variablesWidget.reserve(variablesItems.count());
-    for (QTreeWidgetItem *item : variablesItems) {
-        auto variableWidget = static_cast<VariableWidget *>(item);
-        variablesWidget.append(variableWidget);
+    const QModelIndexList selectedRows = treeView()->selectionModel()->selectedRows();
+    variables.reserve(selectedRows.count());
+    for (const QModelIndex &index : selectedRows) {
+        variables.append(mVariablesModel->variable(mProxyModel->mapToSource(index)));
     }
 
-    return variablesWidget;
+    return variables;
 }
 
-VariableWidget *VariablesWidget::firstSelectedVariableWidget() const
+CTVariable *VariablesWidget::firstSelectedVariable() const
 {
-    QTreeWidgetItem *item = firstSelected();
-    if (!item) {
+    const QModelIndexList selectedRows = treeView()->selectionModel()->selectedRows();
+    if (selectedRows.isEmpty()) {
         return nullptr;
     }
 
-    return static_cast<VariableWidget *>(item);
+    return mVariablesModel->variable(mProxyModel->mapToSource(selectedRows.constFirst()));
 }
 
 void VariablesWidget::deleteSelection()
 {
-    const QList<QTreeWidgetItem *> variablesItems = treeWidget()->selectedItems();
-    bool deleteSomething = !(variablesItems.isEmpty());
+    const QList<CTVariable *> variables = selectedVariables();
+    bool deleteSomething = !(variables.isEmpty());
 
-    for (QTreeWidgetItem *item : variablesItems) {
-        auto variableWidget = static_cast<VariableWidget *>(item);
-
-        crontabWidget()->currentCron()->removeVariable(variableWidget->getCTVariable());
-        delete variableWidget->getCTVariable();
-        treeWidget()->takeTopLevelItem(treeWidget()->indexOfTopLevelItem(variableWidget));
-        delete variableWidget;
+    for (CTVariable *variable : variables) {
+        crontabWidget()->currentCron()->removeVariable(variable);
+        mVariablesModel->removeVariable(variable);
+        delete variable;
     }
 
     if (deleteSomething) {
@@ -126,15 +139,6 @@ bool VariablesWidget::needUserColumn()
     return false;
 }
 
-int VariablesWidget::statusColumnIndex()
-{
-    if (needUserColumn()) {
-        return 3;
-    }
-
-    return 2;
-}
-
 void VariablesWidget::createVariable()
 {
     auto variable = new CTVariable(QLatin1String(""), QLatin1String(""), crontabWidget()->currentCron()->userLogin());
@@ -155,45 +159,26 @@ void VariablesWidget::addVariable(CTVariable *variable)
 {
     qCDebug(KCM_CRON_LOG) << "Add a new variable";
     crontabWidget()->currentCron()->addVariable(variable);
-    new VariableWidget(this, variable);
+    mVariablesModel->addVariable(variable);
 
     changeCurrentSelection();
 }
 
 void VariablesWidget::refreshVariables(CTCron *cron)
 {
-    // Remove previous items
-    removeAll();
-
-    refreshHeaders();
-
-    const auto variables = cron->variables();
-    for (CTVariable *ctVariable : variables) {
-        new VariableWidget(this, ctVariable);
-    }
+    mVariablesModel->setCron(cron);
 
     resizeColumnContents();
 }
 
-void VariablesWidget::refreshHeaders()
+void VariablesWidget::refreshVariables(const CTCronChanges &changes)
 {
-    QStringList headerLabels;
-
-    if (needUserColumn()) {
-        headerLabels << i18n("User");
+    for (CTVariable *variable : changes.removedVariables) {
+        mVariablesModel->removeVariable(variable);
     }
 
-    headerLabels << i18n("Variable");
-    headerLabels << i18n("Value");
-    headerLabels << i18n("Status");
-    headerLabels << i18n("Comment");
-
-    treeWidget()->setHeaderLabels(headerLabels);
-
-    if (needUserColumn()) {
-        treeWidget()->setColumnCount(5);
-    } else {
-        treeWidget()->setColumnCount(4);
+    for (CTVariable *variable : changes.addedVariables) {
+        mVariablesModel->addVariable(variable);
     }
 }
 
@@ -222,18 +207,18 @@ void VariablesWidget::setupActions()
 
 void VariablesWidget::prepareContextualMenu()
 {
-    treeWidget()->addAction(mNewVariableAction);
+    treeView()->addAction(mNewVariableAction);
 
-    treeWidget()->addAction(createSeparator());
+    treeView()->addAction(createSeparator());
 
-    treeWidget()->addAction(mModifyAction);
-    treeWidget()->addAction(mDeleteAction);
+    treeView()->addAction(mModifyAction);
+    treeView()->addAction(mDeleteAction);
 
-    treeWidget()->addAction(createSeparator());
+    treeView()->addAction(createSeparator());
 
     const auto cutCopyPasteActions = crontabWidget()->cutCopyPasteActions();
     for (QAction *action : cutCopyPasteActions) {
-        treeWidget()->addAction(action);
+        treeView()->addAction(action);
     }
 }
 
@@ -253,7 +238,7 @@ void VariablesWidget::changeCurrentSelection()
     qCDebug(KCM_CRON_LOG) << "Change selection...";
 
     bool enabled;
-    if (treeWidget()->selectedItems().isEmpty()) {
+    if (!treeView()->selectionModel()->hasSelection()) {
         enabled = false;
     } else {
         enabled = true;
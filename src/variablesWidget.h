@@ -8,13 +8,15 @@
 
 #pragma once
 
-#include <QTreeWidget>
+#include <QTreeView>
 
 #include "cthost.h"
 #include "genericListWidget.h"
 
-class VariableWidget;
+class CTCronChanges;
 class CTVariable;
+class QSortFilterProxyModel;
+class VariablesModel;
 
 class VariablesWidgetPrivate;
 
@@ -33,12 +35,17 @@ public:
 
     ~VariablesWidget() override;
 
-    QList<VariableWidget *> selectedVariablesWidget() const;
+    QList<CTVariable *> selectedVariables() const;
 
-    VariableWidget *firstSelectedVariableWidget() const;
+    CTVariable *firstSelectedVariable() const;
 
     void refreshVariables(CTCron *cron);
 
+    /**
+     * Only updates the rows of the variables replaced by CTCron::reload().
+     */
+    void refreshVariables(const CTCronChanges &changes);
+
     bool needUserColumn();
 
     /**
@@ -69,12 +76,13 @@ public Q_SLOTS:
     void changeCurrentSelection();
 
 protected Q_SLOTS:
-    void modifySelection(QTreeWidgetItem *item, int position) override;
+    void modifySelection(const QModelIndex &index);
 
 private:
-    void refreshHeaders();
-
-    int statusColumnIndex();
+    /**
+     * Opens the variable editor on @p variable.
+     */
+    void modifyVariable(CTVariable *variable);
 
     void setupActions();
 
@@ -85,5 +93,9 @@ private:
     QAction *mModifyAction = nullptr;
 
     QAction *mDeleteAction = nullptr;
+
+    VariablesModel *mVariablesModel = nullptr;
+
+    QSortFilterProxyModel *mProxyModel = nullptr;
 };
 